@@ -20,14 +20,107 @@
 
 #include <js_native_api.h>
 
-DEPRECATED napi_status napi_create_string_utf16(napi_env env, const char16_t* str, size_t length, napi_value* result);
-DEPRECATED napi_status napi_get_value_string_utf16(napi_env env,
-                                                   napi_value value,
-                                                   char16_t* buf,
-                                                   size_t bufsize,
-                                                   size_t* result);
+// Property name interned by napi_create_property_key, valid as long as its env.
+typedef struct napi_property_key__* napi_property_key;
+
+// Cache for reading one property key from many objects at a single call site. Created by
+// napi_create_property_cache and released by napi_delete_property_cache. On QuickJS every
+// read is a lookup of the interned key and counts as a miss.
+typedef struct napi_property_cache__* napi_property_cache;
+
+// Function and receiver bound by napi_prepare_call for repeated calls with a reusable
+// argument frame. Released by napi_delete_prepared_call, which the called function may
+// also do; the call is then freed when it returns.
+typedef struct napi_prepared_call__* napi_prepared_call;
+
+// Native function described once by napi_create_function_template and instantiated by
+// napi_create_function_from_template in any env. Functions copy the template, so it may be
+// released by napi_delete_function_template while they are alive.
+typedef struct napi_function_template__* napi_function_template;
+
+// Field names of same-shaped objects, interned once by napi_create_object_template for
+// napi_create_object_from_template and napi_define_properties_from_template. Released by
+// napi_delete_object_template.
+typedef struct napi_object_template__* napi_object_template;
+
+// Called by napi_object_for_each for each own enumerable property. Returning false stops the iteration.
+typedef bool (*napi_property_iterator)(napi_env env, napi_value key, napi_value value, void* data);
+
+napi_status napi_create_string_utf16(napi_env env, const char16_t* str, size_t length, napi_value* result);
+napi_status napi_get_value_string_utf16(napi_env env, napi_value value, char16_t* buf, size_t bufsize, size_t* result);
 DEPRECATED napi_status napi_adjust_external_memory(napi_env env, int64_t change_in_bytes, int64_t* adjusted_value);
 napi_status napi_is_callable(napi_env env, napi_value value, bool* result);
+napi_status napi_create_array_with_elements(napi_env env, const napi_value* values, size_t count, napi_value* result);
+napi_status napi_set_elements(napi_env env, napi_value object, uint32_t start, const napi_value* values, size_t count);
+napi_status napi_get_elements(napi_env env, napi_value object, uint32_t start, size_t count, napi_value* results);
+napi_status napi_get_array_numbers(napi_env env,
+                                   napi_value array,
+                                   napi_typedarray_type type,
+                                   void* data,
+                                   size_t length,
+                                   uint32_t* invalid_indices,
+                                   size_t invalid_capacity,
+                                   size_t* invalid_count);
+napi_status napi_create_array_from_numbers(napi_env env,
+                                           napi_typedarray_type type,
+                                           const void* data,
+                                           size_t length,
+                                           napi_value* result);
+napi_status napi_object_for_each(napi_env env, napi_value object, napi_property_iterator callback, void* data);
+napi_status napi_get_named_properties(napi_env env,
+                                      napi_value object,
+                                      const napi_property_key* keys,
+                                      size_t count,
+                                      napi_value* results,
+                                      bool* found);
+napi_status napi_set_named_properties(napi_env env,
+                                      napi_value object,
+                                      const napi_property_key* keys,
+                                      const napi_value* values,
+                                      size_t count,
+                                      bool* results);
+napi_status napi_create_property_key(napi_env env, const char* utf8name, size_t length, napi_property_key* result);
+napi_status napi_set_property_by_key(napi_env env, napi_value object, napi_property_key key, napi_value value);
+napi_status napi_get_property_by_key(napi_env env, napi_value object, napi_property_key key, napi_value* result);
+napi_status napi_has_property_by_key(napi_env env, napi_value object, napi_property_key key, bool* result);
+napi_status napi_delete_property_by_key(napi_env env, napi_value object, napi_property_key key, bool* result);
+napi_status napi_create_property_cache(napi_env env, napi_property_key key, napi_property_cache* result);
+napi_status napi_delete_property_cache(napi_env env, napi_property_cache cache);
+napi_status napi_get_property_cached(napi_env env, napi_value object, napi_property_cache cache, napi_value* result);
+napi_status napi_get_property_cache_stats(napi_env env, napi_property_cache cache, uint64_t* hits, uint64_t* misses);
+napi_status napi_prepare_call(napi_env env, napi_value recv, napi_value func, size_t argc, napi_prepared_call* result);
+napi_status napi_set_prepared_call_argument(napi_env env, napi_prepared_call call, size_t index, napi_value value);
+napi_status napi_invoke_prepared_call(napi_env env, napi_prepared_call call, napi_value* result);
+napi_status napi_delete_prepared_call(napi_env env, napi_prepared_call call);
+napi_status napi_type_tag_object(napi_env env, napi_value js_object, const napi_type_tag* type_tag);
+napi_status napi_check_object_type_tag(napi_env env,
+                                       napi_value js_object,
+                                       const napi_type_tag* type_tag,
+                                       bool* result);
+// Unwraps js_object only when it carries type_tag; result is null for any other object.
+napi_status napi_unwrap_tagged(napi_env env, napi_value js_object, const napi_type_tag* type_tag, void** result);
+napi_status napi_create_function_template(napi_env env,
+                                          napi_callback cb,
+                                          void* data,
+                                          napi_function_template* result);
+napi_status napi_create_function_from_template(napi_env env,
+                                               napi_function_template function_template,
+                                               napi_value* result);
+napi_status napi_delete_function_template(napi_env env, napi_function_template function_template);
+napi_status napi_create_object_template(napi_env env,
+                                        const char* const* utf8names,
+                                        size_t count,
+                                        napi_object_template* result);
+napi_status napi_create_object_from_template(napi_env env,
+                                             napi_object_template object_template,
+                                             const napi_value* values,
+                                             napi_value* result);
+napi_status napi_define_properties_from_template(napi_env env,
+                                                 napi_value object,
+                                                 napi_object_template object_template,
+                                                 const napi_value* values);
+napi_status napi_delete_object_template(napi_env env, napi_object_template object_template);
+napi_status napi_get_value_string_utf8_view(napi_env env, napi_value value, const char** result, size_t* length);
  napi_status napi_create_runtime(napi_env env, napi_env* result_env);
  napi_status napi_serialize(napi_env env, napi_value object, napi_value transfer_list, napi_value* result);
  napi_status napi_deserialize(napi_env env, napi_value recorder, napi_value* object);
@@ -14,8 +14,66 @@
  */
 
 #include "quickjs_native_array.h"
+
+#include <cmath>
+#include <type_traits>
+
 #include "native_engine/native_engine.h"
 #include "quickjs_headers.h"
+#include "utils/log.h"
+
+namespace {
+template<typename T>
+void FillNumbers(JSContext* context, JSValue array, const T* data, size_t length)
+{
+    // Elements appended in index order keep QuickJS's dense fast array representation.
+    for (size_t i = 0; i < length; i++) {
+        JSValue value = std::is_same<T, int32_t>::value ? JS_NewInt32(context, (int32_t)data[i])
+                                                        : JS_NewFloat64(context, (double)data[i]);
+        JS_DefinePropertyValueUint32(context, array, i, value, JS_PROP_C_W_E);
+    }
+}
+
+template<typename T>
+bool UnpackNumbers(JSContext* context,
+                   JSValue array,
+                   T* data,
+                   size_t length,
+                   uint32_t* invalidIndices,
+                   size_t invalidCapacity,
+                   size_t* invalidCount)
+{
+    // Public QuickJS exposes no view of a fast array's elements, so each element still takes
+    // a property lookup. The saving is in not wrapping each element in a NativeValue.
+    *invalidCount = 0;
+    for (size_t i = 0; i < length; i++) {
+        JSValue value = JS_GetPropertyUint32(context, array, i);
+        if (JS_IsException(value)) {
+            return false;
+        }
+        int tag = JS_VALUE_GET_NORM_TAG(value);
+        if (tag == JS_TAG_INT) {
+            data[i] = (T)JS_VALUE_GET_INT(value);
+        } else if (tag == JS_TAG_FLOAT64 && std::is_same<T, int32_t>::value) {
+            int32_t number = 0;
+            if (JS_ToInt32(context, &number, value) < 0) {
+                return false;
+            }
+            data[i] = (T)number;
+        } else if (tag == JS_TAG_FLOAT64) {
+            data[i] = (T)JS_VALUE_GET_FLOAT64(value);
+        } else {
+            data[i] = std::is_same<T, int32_t>::value ? 0 : (T)NAN;
+            if (*invalidCount < invalidCapacity) {
+                invalidIndices[*invalidCount] = (uint32_t)i;
+            }
+            (*invalidCount)++;
+            JS_FreeValue(context, value);
+        }
+    }
+    return true;
+}
+} // namespace
 
 QuickJSNativeArray::QuickJSNativeArray(QuickJSNativeEngine* engine, JSValue value) : QuickJSNativeObject(engine, value)
 {
@@ -27,11 +85,44 @@ QuickJSNativeArray::QuickJSNativeArray(QuickJSNativeEngine* engine, uint32_t len
     value_ = JS_NewArray(engine_->GetContext());
     JSValue jsLength = JS_NewInt32(engine_->GetContext(), length);
     if (length != 0) {
-        JS_SetPropertyStr(engine_->GetContext(), value_, "length", jsLength);
+        JS_SetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_LENGTH), jsLength);
     }
     JS_FreeValue(engine_->GetContext(), jsLength);
 }
 
+QuickJSNativeArray::QuickJSNativeArray(QuickJSNativeEngine* engine, NativeValue* const* values, size_t count)
+    : QuickJSNativeArray(engine, JS_NewArray(engine->GetContext()))
+{
+    // Elements appended in index order keep QuickJS's dense fast array representation.
+    JSContext* context = engine_->GetContext();
+    for (size_t i = 0; i < count; i++) {
+        JS_DefinePropertyValueUint32(context, value_, i, JS_DupValue(context, *values[i]), JS_PROP_C_W_E);
+    }
+}
+
+QuickJSNativeArray::QuickJSNativeArray(QuickJSNativeEngine* engine,
+                                       NativeTypedArrayType type,
+                                       const void* data,
+                                       size_t length)
+    : QuickJSNativeArray(engine, JS_NewArray(engine->GetContext()))
+{
+    JSContext* context = engine_->GetContext();
+    switch (type) {
+        case NATIVE_INT32_ARRAY:
+            FillNumbers(context, value_, static_cast<const int32_t*>(data), length);
+            break;
+        case NATIVE_FLOAT32_ARRAY:
+            FillNumbers(context, value_, static_cast<const float*>(data), length);
+            break;
+        case NATIVE_FLOAT64_ARRAY:
+            FillNumbers(context, value_, static_cast<const double*>(data), length);
+            break;
+        default:
+            HILOG_ERROR("unsupported number type %{public}d", type);
+            break;
+    }
+}
+
 QuickJSNativeArray::~QuickJSNativeArray() {}
 
 void* QuickJSNativeArray::GetInterface(int interfaceId)
@@ -40,6 +131,11 @@ void* QuickJSNativeArray::GetInterface(int interfaceId)
                                                       : QuickJSNativeObject::GetInterface(interfaceId);
 }
 
+NativeValue* QuickJSNativeArray::Duplicate()
+{
+    return new (engine_) QuickJSNativeArray(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
+
 bool QuickJSNativeArray::SetElement(uint32_t index, NativeValue* value)
 {
     return JS_SetPropertyUint32(engine_->GetContext(), value_, index, JS_DupValue(engine_->GetContext(), *value));
@@ -52,6 +148,61 @@ NativeValue* QuickJSNativeArray::GetElement(uint32_t index)
     return QuickJSNativeEngine::JSValueToNativeValue(engine_, value);
 }
 
+bool QuickJSNativeArray::SetElements(uint32_t start, NativeValue* const* values, size_t count, bool* stored)
+{
+    // Public QuickJS has no dense array access, so both directions go element by element.
+    JSContext* context = engine_->GetContext();
+    *stored = true;
+    for (size_t i = 0; i < count; i++) {
+        int result = JS_SetPropertyUint32(context, value_, start + i, JS_DupValue(context, *values[i]));
+        if (result < 0) {
+            return false;
+        }
+        if (result == 0) {
+            *stored = false;
+        }
+    }
+    return true;
+}
+
+bool QuickJSNativeArray::GetElements(uint32_t start, size_t count, NativeValue** values)
+{
+    JSContext* context = engine_->GetContext();
+    for (size_t i = 0; i < count; i++) {
+        JSValue value = JS_GetPropertyUint32(context, value_, start + i);
+        if (JS_IsException(value)) {
+            return false;
+        }
+        values[i] = QuickJSNativeEngine::JSValueToNativeValue(engine_, value);
+    }
+    return true;
+}
+
+bool QuickJSNativeArray::GetNumbers(NativeTypedArrayType type,
+                                    void* data,
+                                    size_t length,
+                                    uint32_t* invalidIndices,
+                                    size_t invalidCapacity,
+                                    size_t* invalidCount)
+{
+    JSContext* context = engine_->GetContext();
+    switch (type) {
+        case NATIVE_INT32_ARRAY:
+            return UnpackNumbers(context, value_, static_cast<int32_t*>(data), length, invalidIndices,
+                                 invalidCapacity, invalidCount);
+        case NATIVE_FLOAT32_ARRAY:
+            return UnpackNumbers(context, value_, static_cast<float*>(data), length, invalidIndices,
+                                 invalidCapacity, invalidCount);
+        case NATIVE_FLOAT64_ARRAY:
+            return UnpackNumbers(context, value_, static_cast<double*>(data), length, invalidIndices,
+                                 invalidCapacity, invalidCount);
+        default:
+            HILOG_ERROR("unsupported number type %{public}d", type);
+            *invalidCount = 0;
+            return true;
+    }
+}
+
 bool QuickJSNativeArray::HasElement(uint32_t index)
 {
     bool result = false;
@@ -63,23 +214,18 @@ bool QuickJSNativeArray::HasElement(uint32_t index)
 
 bool QuickJSNativeArray::DeleteElement(uint32_t index)
 {
-    bool result = false;
-    JSAtom spliceKey = JS_NewAtom(engine_->GetContext(), "splice");
-    JSValue params[] = { JS_NewInt32(engine_->GetContext(), index), JS_NewInt32(engine_->GetContext(), 0) };
-    JSValue spliceResult = JS_Invoke(engine_->GetContext(), value_, spliceKey, 2, params);
-
-    if (!JS_IsNull(spliceResult) && !JS_IsUndefined(spliceResult)) {
-        JS_FreeValue(engine_->GetContext(), value_);
-        value_ = spliceResult;
-        result = true;
-    }
-    JS_FreeAtom(engine_->GetContext(), spliceKey);
-    return result;
+    // Index atoms below 2^31 are tagged integers, so building the key neither allocates nor
+    // hashes. Only a delete of the last element keeps a fast array fast; any other index makes
+    // QuickJS convert the array to its slow representation, which is O(n) and allocates.
+    JSAtom key = JS_NewAtomUInt32(engine_->GetContext(), index);
+    int result = JS_DeleteProperty(engine_->GetContext(), value_, key, 0);
+    JS_FreeAtom(engine_->GetContext(), key);
+    return result == 1;
 }
 
 uint32_t QuickJSNativeArray::GetLength()
 {
-    JSValue jsLength = JS_GetPropertyStr(engine_->GetContext(), value_, "length");
+    JSValue jsLength = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_LENGTH));
     uint32_t cLength = 0;
     JS_ToUint32(engine_->GetContext(), &cLength, jsLength);
     JS_FreeValue(engine_->GetContext(), jsLength);
@@ -22,6 +22,8 @@ class QuickJSNativeArray : public QuickJSNativeObject, public NativeArray {
 public:
     QuickJSNativeArray(QuickJSNativeEngine* engine, JSValue);
     QuickJSNativeArray(QuickJSNativeEngine* engine, uint32_t length);
+    QuickJSNativeArray(QuickJSNativeEngine* engine, NativeValue* const* values, size_t count);
+    QuickJSNativeArray(QuickJSNativeEngine* engine, NativeTypedArrayType type, const void* data, size_t length);
     ~QuickJSNativeArray() override;
 
     bool SetElement(uint32_t index, NativeValue* value) override;
@@ -29,7 +31,17 @@ public:
     virtual bool HasElement(uint32_t index) override;
     virtual bool DeleteElement(uint32_t index) override;
 
+    virtual bool SetElements(uint32_t start, NativeValue* const* values, size_t count, bool* stored) override;
+    virtual bool GetElements(uint32_t start, size_t count, NativeValue** values) override;
+    virtual bool GetNumbers(NativeTypedArrayType type,
+                            void* data,
+                            size_t length,
+                            uint32_t* invalidIndices,
+                            size_t invalidCapacity,
+                            size_t* invalidCount) override;
+
     virtual void* GetInterface(int interfaceId) override;
+    virtual NativeValue* Duplicate() override;
 
     virtual uint32_t GetLength() override;
 };
@@ -69,6 +69,11 @@ void* QuickJSNativeArrayBuffer::GetInterface(int interfaceId)
                                                             : QuickJSNativeObject::GetInterface(interfaceId);
 }
 
+NativeValue* QuickJSNativeArrayBuffer::Duplicate()
+{
+    return new (engine_) QuickJSNativeArrayBuffer(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
+
 void* QuickJSNativeArrayBuffer::GetBuffer()
 {
     void* buffer = nullptr;
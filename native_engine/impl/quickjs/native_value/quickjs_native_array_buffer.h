@@ -26,6 +26,7 @@ public:
     virtual ~QuickJSNativeArrayBuffer();
 
     virtual void* GetInterface(int interfaceId) override;
+    virtual NativeValue* Duplicate() override;
 
     virtual void* GetBuffer() override;
     virtual size_t GetLength() override;
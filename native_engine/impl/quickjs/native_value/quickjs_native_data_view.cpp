@@ -29,19 +29,13 @@ QuickJSNativeDataView::QuickJSNativeDataView(QuickJSNativeEngine* engine,
                                              size_t offset)
     : QuickJSNativeDataView(engine, JS_NULL)
 {
-    JSValue global = JS_GetGlobalObject(engine_->GetContext());
-    JSValue dataView = JS_GetPropertyStr(engine_->GetContext(), global, "DataView");
-
     JSValue param[] = {
         *value,
         JS_NewInt64(engine_->GetContext(), offset),
         JS_NewInt64(engine_->GetContext(), length),
     };
 
-    value_ = JS_CallConstructor(engine_->GetContext(), dataView, 3, param);
-
-    JS_FreeValue(engine_->GetContext(), dataView);
-    JS_FreeValue(engine_->GetContext(), global);
+    value_ = JS_CallConstructor(engine_->GetContext(), engine_->GetDataViewConstructor(), 3, param);
 }
 
 QuickJSNativeDataView::~QuickJSNativeDataView() {}
@@ -52,11 +46,16 @@ void* QuickJSNativeDataView::GetInterface(int interfaceId)
                                                          : QuickJSNativeObject::GetInterface(interfaceId);
 }
 
+NativeValue* QuickJSNativeDataView::Duplicate()
+{
+    return new (engine_) QuickJSNativeDataView(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
+
 void* QuickJSNativeDataView::GetBuffer()
 {
     void* buffer = nullptr;
     size_t bufferSize = 0;
-    JSValue arrayBuffer = JS_GetPropertyStr(engine_->GetContext(), value_, "buffer");
+    JSValue arrayBuffer = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BUFFER));
     buffer = JS_GetArrayBuffer(engine_->GetContext(), &bufferSize, arrayBuffer);
     JS_FreeValue(engine_->GetContext(), arrayBuffer);
     return buffer;
@@ -65,7 +64,7 @@ void* QuickJSNativeDataView::GetBuffer()
 size_t QuickJSNativeDataView::GetLength()
 {
     uint32_t length = 0;
-    JSValue byteLength = JS_GetPropertyStr(engine_->GetContext(), value_, "byteLength");
+    JSValue byteLength = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BYTE_LENGTH));
     JS_ToUint32(engine_->GetContext(), &length, byteLength);
     JS_FreeValue(engine_->GetContext(), byteLength);
     return length;
@@ -73,13 +72,13 @@ size_t QuickJSNativeDataView::GetLength()
 
 NativeValue* QuickJSNativeDataView::GetArrayBuffer()
 {
-    JSValue buffer = JS_GetPropertyStr(engine_->GetContext(), value_, "buffer");
+    JSValue buffer = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BUFFER));
     return QuickJSNativeEngine::JSValueToNativeValue(engine_, buffer);
 }
 
 size_t QuickJSNativeDataView::GetOffset()
 {
-    JSValue byteOffset = JS_GetPropertyStr(engine_->GetContext(), value_, "byteOffset");
+    JSValue byteOffset = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BYTE_OFFSET));
     uint32_t cValue = 0;
     JS_ToUint32(engine_->GetContext(), &cValue, byteOffset);
     JS_FreeValue(engine_->GetContext(), byteOffset);
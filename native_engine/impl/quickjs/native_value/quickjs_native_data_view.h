@@ -25,6 +25,7 @@ public:
     virtual ~QuickJSNativeDataView();
 
     virtual void* GetInterface(int interfaceId) override;
+    virtual NativeValue* Duplicate() override;
 
     virtual void* GetBuffer() override;
     virtual size_t GetLength() override;
@@ -14,31 +14,13 @@
  */
 
 #include "quickjs_native_external.h"
-#include "utils/log.h"
 
 QuickJSNativeExternal::QuickJSNativeExternal(QuickJSNativeEngine* engine,
                                              void* value,
                                              NativeFinalize callback,
                                              void* hint)
-    : QuickJSNativeValue(engine, JS_UNDEFINED)
+    : QuickJSNativeValue(engine, JS_NewNativeExternal(engine->GetContext(), engine, value, callback, hint))
 {
-    NativeObjectInfo* info = new NativeObjectInfo();
-    if (info) {
-        info->engine = engine;
-        info->nativeObject = value;
-        info->callback = callback;
-        info->hint = hint;
-        value_ = JS_NewExternal(
-            engine->GetContext(), info,
-            [](JSContext* context, void* data, void* hint) {
-                auto info = reinterpret_cast<NativeObjectInfo*>(data);
-                info->callback(info->engine, info->nativeObject, info->hint);
-                delete info;
-            },
-            nullptr);
-    } else {
-        HILOG_ERROR("NativeObjectInfo instance create fail.");
-    }
 }
 
 QuickJSNativeExternal::QuickJSNativeExternal(QuickJSNativeEngine* engine, JSValue value)
@@ -53,8 +35,12 @@ void* QuickJSNativeExternal::GetInterface(int interfaceId)
     return (NativeExternal::INTERFACE_ID == interfaceId) ? (NativeExternal*)this : nullptr;
 }
 
+NativeValue* QuickJSNativeExternal::Duplicate()
+{
+    return new (engine_) QuickJSNativeExternal(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
+
 QuickJSNativeExternal::operator void*()
 {
-    NativeObjectInfo* info = (NativeObjectInfo*)JS_ExternalToNativeObject(engine_->GetContext(), value_);
-    return (info != nullptr) ? info->nativeObject : nullptr;
+    return JS_ExternalToNativeObject(engine_->GetContext(), value_);
 }
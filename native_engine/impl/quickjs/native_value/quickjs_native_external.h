@@ -25,6 +25,7 @@ public:
     ~QuickJSNativeExternal() override;
 
     void* GetInterface(int interfaceId) override;
+    NativeValue* Duplicate() override;
     virtual operator void*() override;
 };
 
@@ -21,6 +21,29 @@
 
 #include "utils/log.h"
 
+namespace {
+// The engine, callback and data of a native function are kept in its function data, each
+// pointer split over two immediate int32 slots, so creating a function allocates nothing
+// besides the function object itself.
+enum FunctionDataSlot {
+    FUNCTION_DATA_ENGINE = 0,
+    FUNCTION_DATA_CALLBACK = 2,
+    FUNCTION_DATA_DATA = 4,
+    FUNCTION_DATA_COUNT = 6,
+};
+
+void StorePointer(JSContext* context, JSValue* slots, uint64_t pointer)
+{
+    slots[0] = JS_NewInt32(context, (int32_t)(uint32_t)pointer);
+    slots[1] = JS_NewInt32(context, (int32_t)(uint32_t)(pointer >> 32));
+}
+
+uint64_t LoadPointer(const JSValue* slots)
+{
+    return (uint64_t)(uint32_t)JS_VALUE_GET_INT(slots[0]) | ((uint64_t)(uint32_t)JS_VALUE_GET_INT(slots[1]) << 32);
+}
+} // namespace
+
 QuickJSNativeFunction::QuickJSNativeFunction(QuickJSNativeEngine* engine, JSValue value)
     : QuickJSNativeObject(engine, value)
 {
@@ -32,24 +55,29 @@ QuickJSNativeFunction::QuickJSNativeFunction(QuickJSNativeEngine* engine,
                                              void* value)
     : QuickJSNativeObject(engine, JS_UNDEFINED)
 {
-    NativeFunctionInfo* info = new NativeFunctionInfo();
-    if (info) {
-        info->engine = engine;
-        info->callback = cb;
-        info->data = value;
-        JSValue functionContext = JS_NewExternal(engine_->GetContext(), info,
-            [](JSContext* ctx, void* data, void* hint) {
-                auto info = (NativeFunctionInfo*)data;
-                if (info != nullptr) {
-                    delete info;
-                }
-            },
-        nullptr);
-        value_ = JS_NewCFunctionData(engine_->GetContext(), JSCFunctionData, 0, 0, 1, &functionContext);
-        JS_DefinePropertyValueStr(engine_->GetContext(), value_, "_functionContext", functionContext, 0);
-    } else {
-        HILOG_ERROR("NativeFunctionInfo instance create fail.");
+    NativeFunctionTemplate functionTemplate;
+    functionTemplate.callback = cb;
+    functionTemplate.data = value;
+    value_ = NewFunction(engine, &functionTemplate);
+}
+
+QuickJSNativeFunction::QuickJSNativeFunction(QuickJSNativeEngine* engine,
+                                             const NativeFunctionTemplate* functionTemplate)
+    : QuickJSNativeObject(engine, NewFunction(engine, functionTemplate))
+{
+}
+
+JSValue QuickJSNativeFunction::NewFunction(QuickJSNativeEngine* engine, const NativeFunctionTemplate* functionTemplate)
+{
+    if (functionTemplate == nullptr || functionTemplate->callback == nullptr) {
+        return JS_UNDEFINED;
     }
+    JSContext* context = engine->GetContext();
+    JSValue functionData[FUNCTION_DATA_COUNT];
+    StorePointer(context, functionData + FUNCTION_DATA_ENGINE, (uintptr_t)static_cast<NativeEngine*>(engine));
+    StorePointer(context, functionData + FUNCTION_DATA_CALLBACK, (uintptr_t)functionTemplate->callback);
+    StorePointer(context, functionData + FUNCTION_DATA_DATA, (uintptr_t)functionTemplate->data);
+    return JS_NewCFunctionData(context, JSCFunctionData, 0, 0, FUNCTION_DATA_COUNT, functionData);
 }
 
 QuickJSNativeFunction::~QuickJSNativeFunction() {}
@@ -60,6 +88,11 @@ void* QuickJSNativeFunction::GetInterface(int interfaceId)
                                                          : QuickJSNativeObject::GetInterface(interfaceId);
 }
 
+NativeValue* QuickJSNativeFunction::Duplicate()
+{
+    return new (engine_) QuickJSNativeFunction(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
+
 JSValue QuickJSNativeFunction::JSCFunctionData(JSContext* ctx,
                                                JSValueConst thisVal,
                                                int argc,
@@ -67,7 +100,11 @@ JSValue QuickJSNativeFunction::JSCFunctionData(JSContext* ctx,
                                                int magic,
                                                JSValue* funcData)
 {
-    auto info = (NativeFunctionInfo*)JS_ExternalToNativeObject(ctx, *funcData);
+    NativeFunctionInfo functionInfo;
+    functionInfo.engine = (NativeEngine*)(uintptr_t)LoadPointer(funcData + FUNCTION_DATA_ENGINE);
+    functionInfo.callback = (NativeCallback)(uintptr_t)LoadPointer(funcData + FUNCTION_DATA_CALLBACK);
+    functionInfo.data = (void*)(uintptr_t)LoadPointer(funcData + FUNCTION_DATA_DATA);
+    NativeFunctionInfo* info = &functionInfo;
     NativeValue* value = nullptr;
     NativeCallbackInfo callbackInfo = {0};
 
@@ -83,24 +120,17 @@ JSValue QuickJSNativeFunction::JSCFunctionData(JSContext* ctx,
         return JS_UNDEFINED;
     }
     NativeScope* scope = scopeManager->OpenEscape();
-    callbackInfo.thisVar = QuickJSNativeEngine::JSValueToNativeValue(engine, JS_DupValue(ctx, thisVal));
 
+    // this and the arguments are only wrapped when napi_get_cb_info asks for them, straight
+    // from the argument array QuickJS passed in.
     callbackInfo.argc = argc;
-    callbackInfo.argv = nullptr;
     callbackInfo.functionInfo = info;
-    if (callbackInfo.argc > 0) {
-        callbackInfo.argv = new NativeValue*[argc];
-        for (int i = 0; i < argc; i++) {
-            callbackInfo.argv[i] = QuickJSNativeEngine::JSValueToNativeValue(engine, JS_DupValue(ctx, argv[i]));
-        }
-    }
+    callbackInfo.loader = LoadArgument;
+    callbackInfo.rawArgv = argv;
+    callbackInfo.rawThis = &thisVal;
 
     value = info->callback(info->engine, &callbackInfo);
 
-    if (callbackInfo.argv != nullptr) {
-        delete callbackInfo.argv;
-    }
-
     JSValue result = JS_UNDEFINED;
     if (value != nullptr) {
         result = JS_DupValue(ctx, *value);
@@ -113,3 +143,17 @@ JSValue QuickJSNativeFunction::JSCFunctionData(JSContext* ctx,
     scopeManager->CloseEscape(scope);
     return result;
 }
+
+NativeValue* QuickJSNativeFunction::LoadArgument(NativeCallbackInfo* info, size_t index)
+{
+    auto engine = static_cast<QuickJSNativeEngine*>(info->functionInfo->engine);
+    const JSValue* value = nullptr;
+    if (index == NATIVE_CALLBACK_THIS_INDEX) {
+        value = static_cast<const JSValue*>(info->rawThis);
+    } else if (index == NATIVE_CALLBACK_NEW_TARGET_INDEX) {
+        value = static_cast<const JSValue*>(info->rawNewTarget);
+    } else {
+        value = static_cast<const JSValue*>(info->rawArgv) + index;
+    }
+    return QuickJSNativeEngine::JSValueToNativeValue(engine, JS_DupValue(engine->GetContext(), *value));
+}
@@ -24,9 +24,17 @@ class QuickJSNativeFunction : public QuickJSNativeObject, public NativeFunction
 public:
     QuickJSNativeFunction(QuickJSNativeEngine* engine, JSValue value);
     QuickJSNativeFunction(QuickJSNativeEngine* engine, const char* name, NativeCallback cb, void* value);
+    QuickJSNativeFunction(QuickJSNativeEngine* engine, const NativeFunctionTemplate* functionTemplate);
     virtual ~QuickJSNativeFunction();
 
     virtual void* GetInterface(int interfaceId) override;
+    virtual NativeValue* Duplicate() override;
+
+    // NativeCallbackInfo loader for callbacks whose raw values are QuickJS JSValues.
+    static NativeValue* LoadArgument(NativeCallbackInfo* info, size_t index);
+    // Instantiates functionTemplate in engine, or returns JS_UNDEFINED for a template without
+    // a callback.
+    static JSValue NewFunction(QuickJSNativeEngine* engine, const NativeFunctionTemplate* functionTemplate);
 
 private:
     static JSValue JSCFunctionData(JSContext* ctx,
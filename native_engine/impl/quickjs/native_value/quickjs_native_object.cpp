@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <unordered_set>
+
 #include "native_engine/native_engine.h"
 #include "native_engine/native_property.h"
 
@@ -25,6 +27,78 @@
 #include "quickjs_native_object.h"
 #include "quickjs_native_string.h"
 
+namespace {
+void FreePropertyEnum(JSContext* context, JSPropertyEnum* tab, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        JS_FreeAtom(context, tab[i].atom);
+    }
+    js_free(context, tab);
+}
+
+bool MatchesKeyFilter(JSContext* context, JSValue object, JSAtom atom, int filter)
+{
+    // Key kinds and enumerability are filtered before, along with the property names.
+    if ((filter & (NATIVE_KEY_WRITABLE | NATIVE_KEY_CONFIGURABLE)) == 0) {
+        return true;
+    }
+
+    JSPropertyDescriptor descriptor;
+    if (JS_GetOwnProperty(context, &descriptor, object, atom) <= 0) {
+        return false;
+    }
+    JS_FreeValue(context, descriptor.value);
+    JS_FreeValue(context, descriptor.getter);
+    JS_FreeValue(context, descriptor.setter);
+    if ((filter & NATIVE_KEY_WRITABLE) && !(descriptor.flags & JS_PROP_WRITABLE)) {
+        return false;
+    }
+    if ((filter & NATIVE_KEY_CONFIGURABLE) && !(descriptor.flags & JS_PROP_CONFIGURABLE)) {
+        return false;
+    }
+    return true;
+}
+
+// Whether key is an array index in its canonical form, stored in index when it is.
+bool GetArrayIndex(JSContext* context, JSValue key, uint32_t* index)
+{
+    constexpr size_t maxIndexDigits = 10;
+    constexpr uint64_t maxIndex = 0xFFFFFFFEULL;
+    if (!JS_IsString(key)) {
+        return false;
+    }
+    size_t length = 0;
+    const char* str = JS_ToCStringLen(context, &length, key);
+    if (str == nullptr) {
+        return false;
+    }
+    bool result = (length > 0) && (length <= maxIndexDigits) && (length == 1 || str[0] != '0');
+    uint64_t value = 0;
+    for (size_t i = 0; result && i < length; i++) {
+        result = (str[i] >= '0' && str[i] <= '9');
+        value = value * 10 + (uint64_t)(str[i] - '0');
+    }
+    JS_FreeCString(context, str);
+    if (!result || value > maxIndex) {
+        return false;
+    }
+    *index = (uint32_t)value;
+    return true;
+}
+
+// Array index atoms convert to strings, so numbers are parsed back from them.
+JSValue AtomToKey(JSContext* context, JSAtom atom, NativeKeyConversion conversion)
+{
+    JSValue key = JS_AtomToValue(context, atom);
+    uint32_t index = 0;
+    if (conversion == NATIVE_KEY_KEEP_NUMBERS && GetArrayIndex(context, key, &index)) {
+        JS_FreeValue(context, key);
+        return JS_NewInt64(context, index);
+    }
+    return key;
+}
+} // namespace
+
 QuickJSNativeObject::QuickJSNativeObject(QuickJSNativeEngine* engine)
     : QuickJSNativeObject(engine, JS_NewObject(engine->GetContext()))
 {
@@ -36,35 +110,29 @@ QuickJSNativeObject::QuickJSNativeObject(QuickJSNativeEngine* engine, JSValue va
 
 QuickJSNativeObject::~QuickJSNativeObject() {}
 
-void QuickJSNativeObject::SetNativePointer(void* pointer, NativeFinalize cb, void* hint)
-{
-    NativeObjectInfo* info = (NativeObjectInfo*)JS_GetNativePointer(engine_->GetContext(), value_);
-    if (info == nullptr) {
-        info = new NativeObjectInfo();
-        info->callback = cb;
-        info->engine = engine_;
-        info->nativeObject = pointer;
-        info->hint = hint;
-        JS_SetNativePointer(
-            engine_->GetContext(), value_, info,
-            [](JSContext* context, void* data, void* hint) {
-                auto info = reinterpret_cast<NativeObjectInfo*>(data);
-                if (info) {
-                    info->callback(info->engine, info->nativeObject, info->hint);
-                    delete info;
-                }
-            },
-            hint);
-    } else if (pointer == nullptr) {
-        JS_SetNativePointer(engine_->GetContext(), value_, nullptr, nullptr, nullptr);
-        delete info;
-    }
+bool QuickJSNativeObject::SetNativePointer(void* pointer, NativeFinalize cb, void* hint)
+{
+    return JS_SetNativePointer(engine_->GetContext(), value_, engine_, pointer, cb, hint);
 }
 
 void* QuickJSNativeObject::GetNativePointer()
 {
-    NativeObjectInfo* info = (NativeObjectInfo*)JS_GetNativePointer(engine_->GetContext(), value_);
-    return info ? info->nativeObject : nullptr;
+    return JS_GetNativePointer(engine_->GetContext(), value_);
+}
+
+bool QuickJSNativeObject::SetTypeTag(const NativeTypeTag* tag)
+{
+    return JS_SetTypeTag(engine_->GetContext(), value_, tag);
+}
+
+bool QuickJSNativeObject::CheckTypeTag(const NativeTypeTag* tag)
+{
+    return JS_CheckTypeTag(engine_->GetContext(), value_, tag);
+}
+
+void* QuickJSNativeObject::GetNativePointer(const NativeTypeTag* tag)
+{
+    return JS_GetNativePointerTagged(engine_->GetContext(), value_, tag);
 }
 
 void* QuickJSNativeObject::GetInterface(int interfaceId)
@@ -72,27 +140,105 @@ void* QuickJSNativeObject::GetInterface(int interfaceId)
     return (NativeObject::INTERFACE_ID == interfaceId) ? (NativeObject*)this : nullptr;
 }
 
+NativeValue* QuickJSNativeObject::Duplicate()
+{
+    return new (engine_) QuickJSNativeObject(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
+
 NativeValue* QuickJSNativeObject::GetPropertyNames()
 {
-    JSPropertyEnum* tab = nullptr;
-    uint32_t len = 0;
+    return GetAllPropertyNames(NATIVE_KEY_OWN_ONLY,
+                               NATIVE_KEY_ENUMERABLE | NATIVE_KEY_SKIP_SYMBOLS,
+                               NATIVE_KEY_NUMBERS_TO_STRINGS);
+}
+
+NativeValue* QuickJSNativeObject::GetAllPropertyNames(NativeKeyCollectionMode mode,
+                                                      int filter,
+                                                      NativeKeyConversion conversion)
+{
+    JSContext* context = engine_->GetContext();
+    int flags = 0;
+    if (!(filter & NATIVE_KEY_SKIP_STRINGS)) {
+        flags |= JS_GPN_STRING_MASK;
+    }
+    if (!(filter & NATIVE_KEY_SKIP_SYMBOLS)) {
+        flags |= JS_GPN_SYMBOL_MASK;
+    }
+    // Along the prototype chain every own property shadows the later ones, enumerable or not, so
+    // enumerability is filtered here instead of by QuickJS.
+    bool includePrototypes = (mode == NATIVE_KEY_INCLUDE_PROTOTYPES);
+    if (filter & NATIVE_KEY_ENUMERABLE) {
+        flags |= includePrototypes ? JS_GPN_SET_ENUM : JS_GPN_ENUM_ONLY;
+    }
 
-    JS_GetOwnPropertyNames(engine_->GetContext(), &tab, &len, value_, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY);
+    JSValue names = JS_NewArray(context);
+    uint32_t count = 0;
+    std::unordered_set<JSAtom> seen;
+    JSValue current = JS_DupValue(context, value_);
+    while (JS_IsObject(current)) {
+        JSPropertyEnum* tab = nullptr;
+        uint32_t len = 0;
+        if (JS_GetOwnPropertyNames(context, &tab, &len, current, flags) < 0) {
+            break;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            JSAtom atom = tab[i].atom;
+            if (includePrototypes && !seen.insert(atom).second) {
+                continue;
+            }
+            if (includePrototypes && (filter & NATIVE_KEY_ENUMERABLE) && !tab[i].is_enumerable) {
+                continue;
+            }
+            if (MatchesKeyFilter(context, current, atom, filter)) {
+                JS_DefinePropertyValueUint32(context, names, count++, AtomToKey(context, atom, conversion),
+                                             JS_PROP_C_W_E);
+            }
+        }
+        FreePropertyEnum(context, tab, len);
+
+        if (!includePrototypes) {
+            break;
+        }
+        JSValue prototype = JS_GetPrototype(context, current);
+        JS_FreeValue(context, current);
+        current = prototype;
+    }
+    JS_FreeValue(context, current);
 
-    QuickJSNativeArray* propertyNames = new QuickJSNativeArray(engine_, (uint32_t)0);
+    return new (engine_) QuickJSNativeArray(engine_, names);
+}
 
-    for (uint32_t i = 0; i < len; i++) {
-        QuickJSNativeString* name = new QuickJSNativeString(engine_, tab[i].atom);
-        propertyNames->SetElement(i, name);
+bool QuickJSNativeObject::ForEachProperty(NativePropertyCallback callback, void* data)
+{
+    JSContext* context = engine_->GetContext();
+    JSPropertyEnum* tab = nullptr;
+    uint32_t len = 0;
+    if (JS_GetOwnPropertyNames(context, &tab, &len, value_, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+        return false;
     }
 
-    return propertyNames;
+    NativeScopeManager* scopeManager = engine_->GetScopeManager();
+    bool result = true;
+    bool next = true;
+    for (uint32_t i = 0; i < len && next; i++) {
+        JSValue value = JS_GetProperty(context, value_, tab[i].atom);
+        if (JS_IsException(value)) {
+            result = false;
+            break;
+        }
+        NativeScope* scope = scopeManager->Open();
+        NativeValue* key = new (engine_) QuickJSNativeString(engine_, tab[i].atom);
+        next = callback(key, QuickJSNativeEngine::JSValueToNativeValue(engine_, value), data);
+        scopeManager->Close(scope);
+    }
+    FreePropertyEnum(context, tab, len);
+    return result;
 }
 
 NativeValue* QuickJSNativeObject::GetPrototype()
 {
     JSValue value = JS_GetPrototype(engine_->GetContext(), value_);
-    return new QuickJSNativeObject(engine_, value);
+    return new (engine_) QuickJSNativeObject(engine_, value);
 }
 
 bool QuickJSNativeObject::DefineProperty(NativePropertyDescriptor propertyDescriptor)
@@ -105,19 +251,23 @@ bool QuickJSNativeObject::DefineProperty(NativePropertyDescriptor propertyDescri
         result = JS_DefinePropertyValue(engine_->GetContext(), value_, jKey,
                                         JS_DupValue(engine_->GetContext(), *propertyDescriptor.value), JS_PROP_C_W_E);
     } else if (propertyDescriptor.method) {
-        NativeValue* function = new QuickJSNativeFunction(engine_, propertyDescriptor.utf8name,
-                                                          propertyDescriptor.method, propertyDescriptor.data);
+        NativeFunctionTemplate method;
+        method.callback = propertyDescriptor.method;
+        method.data = propertyDescriptor.data;
         result = JS_DefinePropertyValue(engine_->GetContext(), value_, jKey,
-                                        JS_DupValue(engine_->GetContext(), *function),
+                                        QuickJSNativeFunction::NewFunction(engine_, &method),
                                         JS_PROP_CONFIGURABLE | JS_PROP_WRITABLE);
     } else if (propertyDescriptor.getter || propertyDescriptor.setter) {
-        NativeValue* getter =
-            new QuickJSNativeFunction(engine_, nullptr, propertyDescriptor.getter, propertyDescriptor.data);
-        NativeValue* setter =
-            new QuickJSNativeFunction(engine_, nullptr, propertyDescriptor.setter, propertyDescriptor.data);
-        result =
-            JS_DefinePropertyGetSet(engine_->GetContext(), value_, jKey, JS_DupValue(engine_->GetContext(), *getter),
-                                    JS_DupValue(engine_->GetContext(), *setter), JS_PROP_C_W_E);
+        // A missing accessor stays undefined instead of becoming a function.
+        NativeFunctionTemplate getter;
+        getter.callback = propertyDescriptor.getter;
+        getter.data = propertyDescriptor.data;
+        NativeFunctionTemplate setter;
+        setter.callback = propertyDescriptor.setter;
+        setter.data = propertyDescriptor.data;
+        result = JS_DefinePropertyGetSet(engine_->GetContext(), value_, jKey,
+                                         QuickJSNativeFunction::NewFunction(engine_, &getter),
+                                         QuickJSNativeFunction::NewFunction(engine_, &setter), JS_PROP_C_W_E);
     }
 
     JS_FreeAtom(engine_->GetContext(), jKey);
@@ -192,6 +342,78 @@ bool QuickJSNativeObject::DeleteProperty(const char* name)
     return result;
 }
 
+bool QuickJSNativeObject::SetProperty(const NativePropertyKey* key, NativeValue* value)
+{
+    return JS_SetProperty(engine_->GetContext(), value_, key->id, JS_DupValue(engine_->GetContext(), *value));
+}
+
+NativeValue* QuickJSNativeObject::GetProperty(const NativePropertyKey* key)
+{
+    JSValue value = JS_GetProperty(engine_->GetContext(), value_, key->id);
+    return QuickJSNativeEngine::JSValueToNativeValue(engine_, value);
+}
+
+bool QuickJSNativeObject::HasProperty(const NativePropertyKey* key)
+{
+    return JS_HasProperty(engine_->GetContext(), value_, key->id);
+}
+
+bool QuickJSNativeObject::DeleteProperty(const NativePropertyKey* key)
+{
+    return JS_DeleteProperty(engine_->GetContext(), value_, key->id, JS_PROP_THROW);
+}
+
+NativeValue* QuickJSNativeObject::GetProperty(NativePropertyCache* cache)
+{
+    // QuickJS exports no access to object shapes, so there is no inline cache to hit and each
+    // read is a lookup of the interned key.
+    cache->misses++;
+    JSValue value = JS_GetProperty(engine_->GetContext(), value_, cache->key->id);
+    return QuickJSNativeEngine::JSValueToNativeValue(engine_, value);
+}
+
+bool QuickJSNativeObject::GetProperties(const NativePropertyKey* const* keys,
+                                        size_t count,
+                                        NativeValue** values,
+                                        bool* found)
+{
+    JSContext* context = engine_->GetContext();
+    for (size_t i = 0; i < count; i++) {
+        JSValue value = JS_GetProperty(context, value_, keys[i]->id);
+        if (JS_IsException(value)) {
+            return false;
+        }
+        if (found != nullptr) {
+            // Only an undefined value needs a second lookup to tell a missing key apart.
+            int result = JS_IsUndefined(value) ? JS_HasProperty(context, value_, keys[i]->id) : 1;
+            if (result < 0) {
+                return false;
+            }
+            found[i] = (result == 1);
+        }
+        values[i] = QuickJSNativeEngine::JSValueToNativeValue(engine_, value);
+    }
+    return true;
+}
+
+bool QuickJSNativeObject::SetProperties(const NativePropertyKey* const* keys,
+                                        NativeValue* const* values,
+                                        size_t count,
+                                        bool* results)
+{
+    JSContext* context = engine_->GetContext();
+    for (size_t i = 0; i < count; i++) {
+        int result = JS_SetProperty(context, value_, keys[i]->id, JS_DupValue(context, *values[i]));
+        if (result < 0) {
+            return false;
+        }
+        if (results != nullptr) {
+            results[i] = (result == 1);
+        }
+    }
+    return true;
+}
+
 bool QuickJSNativeObject::SetPrivateProperty(const char* name, NativeValue* value)
 {
     bool result = false;
@@ -25,12 +25,20 @@ public:
     virtual ~QuickJSNativeObject();
 
     virtual void* GetInterface(int interfaceId) override;
+    virtual NativeValue* Duplicate() override;
 
-    virtual void SetNativePointer(void* pointer, NativeFinalize cb, void* hint) override;
+    virtual bool SetNativePointer(void* pointer, NativeFinalize cb, void* hint) override;
 
     virtual void* GetNativePointer() override;
+    virtual bool SetTypeTag(const NativeTypeTag* tag) override;
+    virtual bool CheckTypeTag(const NativeTypeTag* tag) override;
+    virtual void* GetNativePointer(const NativeTypeTag* tag) override;
 
     virtual NativeValue* GetPropertyNames() override;
+    virtual NativeValue* GetAllPropertyNames(NativeKeyCollectionMode mode,
+                                             int filter,
+                                             NativeKeyConversion conversion) override;
+    virtual bool ForEachProperty(NativePropertyCallback callback, void* data) override;
 
     virtual NativeValue* GetPrototype() override;
 
@@ -46,6 +54,21 @@ public:
     virtual bool HasProperty(const char* name) override;
     virtual bool DeleteProperty(const char* name) override;
 
+    virtual bool SetProperty(const NativePropertyKey* key, NativeValue* value) override;
+    virtual NativeValue* GetProperty(const NativePropertyKey* key) override;
+    virtual bool HasProperty(const NativePropertyKey* key) override;
+    virtual bool DeleteProperty(const NativePropertyKey* key) override;
+    virtual NativeValue* GetProperty(NativePropertyCache* cache) override;
+
+    virtual bool GetProperties(const NativePropertyKey* const* keys,
+                               size_t count,
+                               NativeValue** values,
+                               bool* found) override;
+    virtual bool SetProperties(const NativePropertyKey* const* keys,
+                               NativeValue* const* values,
+                               size_t count,
+                               bool* results) override;
+
     virtual bool SetPrivateProperty(const char* name, NativeValue* value) override;
     virtual NativeValue* GetPrivateProperty(const char* name) override;
     virtual bool HasPrivateProperty(const char* name) override;
@@ -19,7 +19,61 @@
 
 #include "securec.h"
 
-QuickJSNativeString::QuickJSNativeString(QuickJSNativeEngine* engine, JSValue value) : QuickJSNativeValue(engine, value)
+namespace {
+// Size of the UTF-8 sequence starting with lead, as written by JS_ToCStringLen. Lone
+// surrogates take three bytes, like the other characters below 0x10000.
+size_t Utf8SequenceSize(uint8_t lead)
+{
+    return (lead < 0x80) ? 1 : ((lead < 0xE0) ? 2 : ((lead < 0xF0) ? 3 : 4));
+}
+
+// Decodes UTF-8 into 16 bit units stored as T, stopping before a character whose units do not
+// all fit in size. Only counts the units when buffer is null. Narrower T keeps the low bits
+// of each unit.
+template<typename T>
+size_t DecodeUtf8(const char* str, size_t length, T* buffer, size_t size)
+{
+    auto data = reinterpret_cast<const uint8_t*>(str);
+    size_t count = 0;
+    size_t i = 0;
+    while (i < length && count < size) {
+        uint32_t codePoint = data[i];
+        size_t sequenceSize = Utf8SequenceSize(data[i]);
+        if (i + sequenceSize > length) {
+            break;
+        }
+        if (sequenceSize == 2) {
+            codePoint = ((codePoint & 0x1F) << 6) | (data[i + 1] & 0x3F);
+        } else if (sequenceSize == 3) {
+            codePoint = ((codePoint & 0x0F) << 12) | ((data[i + 1] & 0x3F) << 6) | (data[i + 2] & 0x3F);
+        } else if (sequenceSize == 4) {
+            codePoint = ((codePoint & 0x07) << 18) | ((data[i + 1] & 0x3F) << 12) | ((data[i + 2] & 0x3F) << 6) |
+                        (data[i + 3] & 0x3F);
+        }
+        if (codePoint >= 0x10000) {
+            if (size - count < 2) {
+                break;
+            }
+            codePoint -= 0x10000;
+            if (buffer != nullptr) {
+                buffer[count] = (T)(0xD800 + (codePoint >> 10));
+                buffer[count + 1] = (T)(0xDC00 + (codePoint & 0x3FF));
+            }
+            count += 2;
+        } else {
+            if (buffer != nullptr) {
+                buffer[count] = (T)codePoint;
+            }
+            count++;
+        }
+        i += sequenceSize;
+    }
+    return count;
+}
+} // namespace
+
+QuickJSNativeString::QuickJSNativeString(QuickJSNativeEngine* engine, JSValue value)
+    : QuickJSNativeValue(engine, value), cString_(nullptr), length_(0)
 {
 }
 
@@ -33,7 +87,12 @@ QuickJSNativeString::QuickJSNativeString(QuickJSNativeEngine* engine, const char
 {
 }
 
-QuickJSNativeString::~QuickJSNativeString() {}
+QuickJSNativeString::~QuickJSNativeString()
+{
+    if (cString_ != nullptr) {
+        JS_FreeCString(engine_->GetContext(), cString_);
+    }
+}
 
 void* QuickJSNativeString::GetInterface(int interfaceId)
 {
@@ -42,7 +101,7 @@ void* QuickJSNativeString::GetInterface(int interfaceId)
 
 void QuickJSNativeString::GetCString(char* buffer, size_t size, size_t* length)
 {
-    const char* str = JS_ToCStringLen(engine_->GetContext(), length, value_);
+    const char* str = GetCStringView(length);
 
     if (str == nullptr) {
         HILOG_ERROR("JS_ToCStringLen return value is null");
@@ -55,14 +114,69 @@ void QuickJSNativeString::GetCString(char* buffer, size_t size, size_t* length)
             HILOG_ERROR("strncpy_s failed");
         }
     }
-    JS_FreeCString(engine_->GetContext(), str);
+}
+
+const char* QuickJSNativeString::GetCStringView(size_t* length)
+{
+    if (cString_ == nullptr) {
+        size_t cLength = 0;
+        cString_ = JS_ToCStringLen(engine_->GetContext(), &cLength, value_);
+        if (cString_ == nullptr) {
+            return nullptr;
+        }
+        length_ = cLength;
+    }
+    if (length != nullptr) {
+        *length = length_;
+    }
+    return cString_;
+}
+
+void QuickJSNativeString::GetCStringLatin1(char* buffer, size_t size, size_t* length)
+{
+    size_t cLength = 0;
+    const char* str = GetCStringView(&cLength);
+    if (str == nullptr) {
+        *length = 0;
+        return;
+    }
+    if (buffer == nullptr) {
+        *length = DecodeUtf8<char>(str, cLength, nullptr, SIZE_MAX);
+        return;
+    }
+    if (size == 0) {
+        *length = 0;
+        return;
+    }
+    // Characters above 0xFF keep their low byte, as other engines do.
+    *length = DecodeUtf8(str, cLength, buffer, size - 1);
+    buffer[*length] = '\0';
+}
+
+void QuickJSNativeString::GetCStringUtf16(char16_t* buffer, size_t size, size_t* length)
+{
+    size_t cLength = 0;
+    const char* str = GetCStringView(&cLength);
+    if (str == nullptr) {
+        *length = 0;
+        return;
+    }
+    if (buffer == nullptr) {
+        *length = DecodeUtf8<char16_t>(str, cLength, nullptr, SIZE_MAX);
+        return;
+    }
+    if (size == 0) {
+        *length = 0;
+        return;
+    }
+    *length = DecodeUtf8(str, cLength, buffer, size - 1);
+    buffer[*length] = u'\0';
 }
 
 size_t QuickJSNativeString::GetLength()
 {
     size_t length = 0;
-    GetCString(nullptr, 0, &length);
-    return length;
+    return (GetCStringView(&length) != nullptr) ? length : 0;
 }
 
 size_t QuickJSNativeString::EncodeWriteUtf8(char* buffer, size_t bufferSize, int32_t* nchars)
@@ -72,45 +186,28 @@ size_t QuickJSNativeString::EncodeWriteUtf8(char* buffer, size_t bufferSize, int
         return 0;
     }
 
-    JSContext *ctx = engine_->GetContext();
-    JSValue lengthVal = JS_GetPropertyStr(ctx, value_, "length");
-    if (JS_IsException(lengthVal)) {
-        HILOG_ERROR("Failed to obtain the length");
-        return 0;
-    }
-    uint32_t len = 0;
-    if (JS_ToUint32(ctx, &len, lengthVal)) {
-        JS_FreeValue(ctx, lengthVal);
-        HILOG_ERROR("Cannot convert length to uint32_t");
+    size_t length = 0;
+    const char* str = GetCStringView(&length);
+    *nchars = 0;
+    if (str == nullptr) {
         return 0;
     }
 
+    // Only whole characters are written. Four byte sequences count as two units.
     size_t pos = 0;
-    size_t writableSize = bufferSize;
-    uint32_t i = 0;
-    for (; i < len; i++) {
-        JSValue ch = JS_GetPropertyUint32(ctx, value_, i);
-        size_t chLen = 0;
-        const char* str = JS_ToCStringLen(ctx, &chLen, ch);
-        JS_FreeValue(ctx, ch);
-        if (chLen > writableSize) {
-            JS_FreeCString(ctx, str);
+    int32_t count = 0;
+    while (pos < length) {
+        size_t sequenceSize = Utf8SequenceSize((uint8_t)str[pos]);
+        if (bufferSize - pos < sequenceSize) {
             break;
         }
-
-        int ret = memcpy_s((buffer + pos), writableSize, str, chLen);
-        if (ret != EOK) {
-            HILOG_ERROR("memcpy_s failed");
-            JS_FreeCString(ctx, str);
-            break;
-        }
-
-        writableSize -= chLen;
-        pos = bufferSize - writableSize;
-        JS_FreeCString(ctx, str);
+        pos += sequenceSize;
+        count += (sequenceSize == 4) ? 2 : 1;
     }
-
-    *nchars = i;
-    JS_FreeValue(ctx, lengthVal);
+    if (pos > 0 && memcpy_s(buffer, bufferSize, str, pos) != EOK) {
+        HILOG_ERROR("memcpy_s failed");
+        return 0;
+    }
+    *nchars = count;
     return pos;
 }
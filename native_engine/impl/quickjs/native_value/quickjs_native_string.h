@@ -16,6 +16,8 @@
 #ifndef FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_NATIVE_VALUE_QUICKJS_NATIVE_STRING_H
 #define FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_NATIVE_VALUE_QUICKJS_NATIVE_STRING_H
 
+#include <cstdint>
+
 #include "quickjs_native_value.h"
 
 class QuickJSNativeString : public QuickJSNativeValue, public NativeString {
@@ -28,8 +30,16 @@ public:
     virtual void* GetInterface(int interfaceId) override;
 
     virtual void GetCString(char* buffer, size_t size, size_t* length) override;
+    virtual const char* GetCStringView(size_t* length) override;
+    virtual void GetCStringLatin1(char* buffer, size_t size, size_t* length) override;
+    virtual void GetCStringUtf16(char16_t* buffer, size_t size, size_t* length) override;
     virtual size_t GetLength() override;
     virtual size_t EncodeWriteUtf8(char* buffer, size_t bufferSize, int32_t* nchars) override;
+
+private:
+    // UTF-8 conversion kept for the lifetime of the wrapper, which ends when its scope closes.
+    const char* cString_;
+    size_t length_;
 };
 
 #endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_NATIVE_VALUE_QUICKJS_NATIVE_STRING_H */
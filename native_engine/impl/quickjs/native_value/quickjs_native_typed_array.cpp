@@ -15,7 +15,104 @@
 
 #include "quickjs_native_typed_array.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string.h>
+#include <type_traits>
+
+#include "utils/log.h"
+
+namespace {
+// ToInt32 of ECMAScript: truncates and wraps modulo 2^32.
+int32_t DoubleToInt32(double value)
+{
+    constexpr double twoPow32 = 4294967296.0;
+    if (!std::isfinite(value)) {
+        return 0;
+    }
+    double wrapped = std::fmod(std::trunc(value), twoPow32);
+    if (wrapped < 0) {
+        wrapped += twoPow32;
+    }
+    return (int32_t)(uint32_t)wrapped;
+}
+
+// Plain loops over contiguous elements, which the compiler vectorizes.
+template<typename From, typename To>
+void ConvertNumbers(const uint8_t* source, To* destination, size_t count)
+{
+    const From* elements = reinterpret_cast<const From*>(source);
+    if (std::is_same<To, int32_t>::value && std::is_floating_point<From>::value) {
+        for (size_t i = 0; i < count; i++) {
+            destination[i] = (To)DoubleToInt32((double)elements[i]);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            destination[i] = (To)elements[i];
+        }
+    }
+}
+
+template<typename To>
+bool ConvertTypedArray(NativeTypedArrayType sourceType, const uint8_t* source, To* destination, size_t count)
+{
+    switch (sourceType) {
+        case NATIVE_INT8_ARRAY:
+            ConvertNumbers<int8_t>(source, destination, count);
+            return true;
+        case NATIVE_UINT8_ARRAY:
+        case NATIVE_UINT8_CLAMPED_ARRAY:
+            ConvertNumbers<uint8_t>(source, destination, count);
+            return true;
+        case NATIVE_INT16_ARRAY:
+            ConvertNumbers<int16_t>(source, destination, count);
+            return true;
+        case NATIVE_UINT16_ARRAY:
+            ConvertNumbers<uint16_t>(source, destination, count);
+            return true;
+        case NATIVE_INT32_ARRAY:
+            ConvertNumbers<int32_t>(source, destination, count);
+            return true;
+        case NATIVE_UINT32_ARRAY:
+            ConvertNumbers<uint32_t>(source, destination, count);
+            return true;
+        case NATIVE_FLOAT32_ARRAY:
+            ConvertNumbers<float>(source, destination, count);
+            return true;
+        case NATIVE_FLOAT64_ARRAY:
+            ConvertNumbers<double>(source, destination, count);
+            return true;
+        default:
+            // BigInt elements are not numbers.
+            return false;
+    }
+}
+
+template<typename To>
+size_t GetTypedArrayNumbers(NativeTypedArrayType sourceType,
+                            const uint8_t* source,
+                            size_t elementCount,
+                            To* destination,
+                            size_t length,
+                            uint32_t* invalidIndices,
+                            size_t invalidCapacity)
+{
+    size_t count = std::min(elementCount, length);
+    if (source == nullptr || !ConvertTypedArray(sourceType, source, destination, count)) {
+        count = 0;
+    }
+
+    size_t invalidCount = 0;
+    for (size_t i = count; i < length; i++) {
+        destination[i] = std::is_same<To, int32_t>::value ? 0 : (To)NAN;
+        if (invalidCount < invalidCapacity) {
+            invalidIndices[invalidCount] = (uint32_t)i;
+        }
+        invalidCount++;
+    }
+    return invalidCount;
+}
+} // namespace
 
 QuickJSNativeTypedArray::QuickJSNativeTypedArray(QuickJSNativeEngine* engine, JSValue value)
     : QuickJSNativeObject(engine, value)
@@ -29,46 +126,23 @@ QuickJSNativeTypedArray::QuickJSNativeTypedArray(QuickJSNativeEngine* engine,
                                                  size_t offset)
     : QuickJSNativeTypedArray(engine, JS_NULL)
 {
-    JSValue jsGlobal = JS_GetGlobalObject(engine_->GetContext());
-    JSValue jsType;
     switch (type) {
-        case NativeTypedArrayType::NATIVE_UINT8_CLAMPED_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Uint8ClampedArray");
-            break;
-        case NativeTypedArrayType::NATIVE_INT8_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Int8Array");
-            break;
-        case NativeTypedArrayType::NATIVE_UINT8_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Uint8Array");
-            break;
         case NativeTypedArrayType::NATIVE_INT16_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Int16Array");
             length = length / sizeof(int16_t);
             break;
         case NativeTypedArrayType::NATIVE_UINT16_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Uint16Array");
             length = length / sizeof(uint16_t);
             break;
         case NativeTypedArrayType::NATIVE_INT32_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Int32Array");
             length = length / sizeof(int32_t);
             break;
         case NativeTypedArrayType::NATIVE_UINT32_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Uint32Array");
             length = length / sizeof(uint32_t);
             break;
-        case NativeTypedArrayType::NATIVE_BIGINT64_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "BigInt64Array");
-            break;
-        case NativeTypedArrayType::NATIVE_BIGUINT64_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "BigUint64Array");
-            break;
         case NativeTypedArrayType::NATIVE_FLOAT32_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Float32Array");
             length = length / sizeof(float);
             break;
         case NativeTypedArrayType::NATIVE_FLOAT64_ARRAY:
-            jsType = JS_GetPropertyStr(engine_->GetContext(), jsGlobal, "Float64Array");
             length = length / sizeof(double);
             break;
         default:;
@@ -78,9 +152,7 @@ QuickJSNativeTypedArray::QuickJSNativeTypedArray(QuickJSNativeEngine* engine,
         JS_NewInt64(engine_->GetContext(), offset),
         JS_NewInt64(engine_->GetContext(), length),
     };
-    value_ = JS_CallConstructor(engine_->GetContext(), jsType, 3, params);
-    JS_FreeValue(engine_->GetContext(), jsType);
-    JS_FreeValue(engine_->GetContext(), jsGlobal);
+    value_ = JS_CallConstructor(engine_->GetContext(), engine_->GetTypedArrayConstructor(type), 3, params);
 }
 
 QuickJSNativeTypedArray::~QuickJSNativeTypedArray() {}
@@ -91,48 +163,21 @@ void* QuickJSNativeTypedArray::GetInterface(int interfaceId)
                                                            : QuickJSNativeObject::GetInterface(interfaceId);
 }
 
-NativeTypedArrayType QuickJSNativeTypedArray::GetTypedArrayType()
+NativeValue* QuickJSNativeTypedArray::Duplicate()
 {
-    JSValue constructor = JS_GetPropertyStr(engine_->GetContext(), value_, "constructor");
-    JSValue constructorName = JS_GetPropertyStr(engine_->GetContext(), constructor, "name");
-    const char* cConstructorName = JS_ToCString(engine_->GetContext(), constructorName);
-
-    NativeTypedArrayType typedArrayType;
-
-    if (!strcmp(cConstructorName, "Uint8ClampedArray")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_UINT8_CLAMPED_ARRAY;
-    } else if (!strcmp(cConstructorName, "Int8Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_INT8_ARRAY;
-    } else if (!strcmp(cConstructorName, "Uint8Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_UINT8_ARRAY;
-    } else if (!strcmp(cConstructorName, "Int16Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_INT16_ARRAY;
-    } else if (!strcmp(cConstructorName, "Uint16Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_UINT16_ARRAY;
-    } else if (!strcmp(cConstructorName, "Int32Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_INT32_ARRAY;
-    } else if (!strcmp(cConstructorName, "Uint32Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_UINT32_ARRAY;
-    } else if (!strcmp(cConstructorName, "BigInt64Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_BIGINT64_ARRAY;
-    } else if (!strcmp(cConstructorName, "BigUint64Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_BIGUINT64_ARRAY;
-    } else if (!strcmp(cConstructorName, "Float32Array")) {
-        typedArrayType = NativeTypedArrayType::NATIVE_FLOAT32_ARRAY;
-    } else {
-        typedArrayType = NativeTypedArrayType::NATIVE_FLOAT64_ARRAY;
-    }
-
-    JS_FreeCString(engine_->GetContext(), cConstructorName);
-    JS_FreeValue(engine_->GetContext(), constructorName);
-    JS_FreeValue(engine_->GetContext(), constructor);
+    return new (engine_) QuickJSNativeTypedArray(engine_, JS_DupValue(engine_->GetContext(), value_));
+}
 
-    return typedArrayType;
+NativeTypedArrayType QuickJSNativeTypedArray::GetTypedArrayType()
+{
+    NativeTypedArrayType type = NativeTypedArrayType::NATIVE_FLOAT64_ARRAY;
+    engine_->GetTypedArrayType(value_, &type);
+    return type;
 }
 
 size_t QuickJSNativeTypedArray::GetLength()
 {
-    JSValue byteLength = JS_GetPropertyStr(engine_->GetContext(), value_, "byteLength");
+    JSValue byteLength = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BYTE_LENGTH));
     size_t result = JS_VALUE_GET_INT(byteLength);
     JS_FreeValue(engine_->GetContext(), byteLength);
 
@@ -141,7 +186,7 @@ size_t QuickJSNativeTypedArray::GetLength()
 
 NativeValue* QuickJSNativeTypedArray::GetArrayBuffer()
 {
-    JSValue arrayBuffer = JS_GetPropertyStr(engine_->GetContext(), value_, "buffer");
+    JSValue arrayBuffer = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BUFFER));
 
     return QuickJSNativeEngine::JSValueToNativeValue(engine_, arrayBuffer);
 }
@@ -150,7 +195,7 @@ void* QuickJSNativeTypedArray::GetData()
 {
     void* buffer = nullptr;
     size_t bufferSize;
-    JSValue arrayBuffer = JS_GetPropertyStr(engine_->GetContext(), value_, "buffer");
+    JSValue arrayBuffer = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BUFFER));
     buffer = JS_GetArrayBuffer(engine_->GetContext(), &bufferSize, arrayBuffer);
     JS_FreeValue(engine_->GetContext(), arrayBuffer);
 
@@ -159,10 +204,50 @@ void* QuickJSNativeTypedArray::GetData()
 
 size_t QuickJSNativeTypedArray::GetOffset()
 {
-    JSValue byteOffset = JS_GetPropertyStr(engine_->GetContext(), value_, "byteOffset");
+    JSValue byteOffset = JS_GetProperty(engine_->GetContext(), value_, engine_->GetAtom(QUICKJS_ATOM_BYTE_OFFSET));
     uint32_t cValue = 0;
     JS_ToUint32(engine_->GetContext(), &cValue, byteOffset);
     JS_FreeValue(engine_->GetContext(), byteOffset);
 
     return cValue;
 }
+
+bool QuickJSNativeTypedArray::GetNumbers(NativeTypedArrayType type,
+                                         void* data,
+                                         size_t length,
+                                         uint32_t* invalidIndices,
+                                         size_t invalidCapacity,
+                                         size_t* invalidCount)
+{
+    JSContext* context = engine_->GetContext();
+    size_t byteOffset = 0;
+    size_t byteLength = 0;
+    size_t bytesPerElement = 0;
+    JSValue arrayBuffer = JS_GetTypedArrayBuffer(context, value_, &byteOffset, &byteLength, &bytesPerElement);
+    size_t bufferSize = 0;
+    uint8_t* buffer = JS_IsException(arrayBuffer) ? nullptr : JS_GetArrayBuffer(context, &bufferSize, arrayBuffer);
+    const uint8_t* source = (buffer != nullptr) ? buffer + byteOffset : nullptr;
+    size_t elementCount = (bytesPerElement != 0) ? byteLength / bytesPerElement : 0;
+    NativeTypedArrayType sourceType = GetTypedArrayType();
+
+    *invalidCount = 0;
+    switch (type) {
+        case NATIVE_INT32_ARRAY:
+            *invalidCount = GetTypedArrayNumbers(sourceType, source, elementCount, static_cast<int32_t*>(data),
+                                                 length, invalidIndices, invalidCapacity);
+            break;
+        case NATIVE_FLOAT32_ARRAY:
+            *invalidCount = GetTypedArrayNumbers(sourceType, source, elementCount, static_cast<float*>(data),
+                                                 length, invalidIndices, invalidCapacity);
+            break;
+        case NATIVE_FLOAT64_ARRAY:
+            *invalidCount = GetTypedArrayNumbers(sourceType, source, elementCount, static_cast<double*>(data),
+                                                 length, invalidIndices, invalidCapacity);
+            break;
+        default:
+            HILOG_ERROR("unsupported number type %{public}d", type);
+            break;
+    }
+    JS_FreeValue(context, arrayBuffer);
+    return true;
+}
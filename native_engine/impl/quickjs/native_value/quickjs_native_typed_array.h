@@ -29,12 +29,19 @@ public:
     virtual ~QuickJSNativeTypedArray() override;
 
     virtual void* GetInterface(int interfaceId) override;
+    virtual NativeValue* Duplicate() override;
 
     virtual NativeTypedArrayType GetTypedArrayType() override;
     virtual NativeValue* GetArrayBuffer() override;
     virtual void* GetData() override;
     virtual size_t GetLength() override;
     virtual size_t GetOffset() override;
+    virtual bool GetNumbers(NativeTypedArrayType type,
+                            void* data,
+                            size_t length,
+                            uint32_t* invalidIndices,
+                            size_t invalidCapacity,
+                            size_t* invalidCount) override;
 };
 
 #endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_NATIVE_VALUE_QUICKJS_NATIVE_TYPED_ARRAY_H */
@@ -24,10 +24,6 @@ QuickJSNativeValue::QuickJSNativeValue(QuickJSNativeEngine* engine, JSValue valu
 {
     value_ = value;
     engine_ = engine;
-    NativeScopeManager* scopeManager = engine_->GetScopeManager();
-    if (scopeManager != nullptr) {
-        scopeManager->CreateHandle(this);
-    }
 }
 
 QuickJSNativeValue::~QuickJSNativeValue()
@@ -35,6 +31,28 @@ QuickJSNativeValue::~QuickJSNativeValue()
     JS_FreeValue(engine_->GetContext(), value_);
 }
 
+void* QuickJSNativeValue::operator new(size_t size, QuickJSNativeEngine* engine)
+{
+    NativeScopeManager* scopeManager = engine->GetScopeManager();
+    if (scopeManager == nullptr) {
+        return ::operator new(size);
+    }
+    void* ptr = scopeManager->AllocValue(size);
+    if (ptr == nullptr) {
+        // Too large to be stored inline, the handle owns a heap allocation instead.
+        ptr = ::operator new(size);
+        scopeManager->CreateHandle(reinterpret_cast<NativeValue*>(ptr));
+    }
+    return ptr;
+}
+
+void QuickJSNativeValue::operator delete(void* ptr, QuickJSNativeEngine* engine) {}
+
+void QuickJSNativeValue::operator delete(void* ptr)
+{
+    ::operator delete(ptr);
+}
+
 void* QuickJSNativeValue::GetInterface(int interfaceId)
 {
     return nullptr;
@@ -91,12 +109,12 @@ bool QuickJSNativeValue::IsArray()
 
 bool QuickJSNativeValue::IsArrayBuffer()
 {
-    return JS_IsArrayBuffer(engine_->GetContext(), value_);
+    return engine_->GetIntrinsicType(value_) == QUICKJS_INTRINSIC_ARRAY_BUFFER;
 }
 
 bool QuickJSNativeValue::IsDate()
 {
-    return JS_IsDate(engine_->GetContext(), value_);
+    return engine_->GetIntrinsicType(value_) == QUICKJS_INTRINSIC_DATE;
 }
 
 bool QuickJSNativeValue::IsError()
@@ -106,17 +124,17 @@ bool QuickJSNativeValue::IsError()
 
 bool QuickJSNativeValue::IsTypedArray()
 {
-    return JS_IsTypedArray(engine_->GetContext(), value_);
+    return engine_->GetIntrinsicType(value_) == QUICKJS_INTRINSIC_TYPED_ARRAY;
 }
 
 bool QuickJSNativeValue::IsDataView()
 {
-    return JS_IsDataView(engine_->GetContext(), value_);
+    return engine_->GetIntrinsicType(value_) == QUICKJS_INTRINSIC_DATA_VIEW;
 }
 
 bool QuickJSNativeValue::IsPromise()
 {
-    return JS_IsPromise(engine_->GetContext(), value_);
+    return engine_->GetIntrinsicType(value_) == QUICKJS_INTRINSIC_PROMISE;
 }
 
 bool QuickJSNativeValue::IsCallable()
@@ -127,14 +145,14 @@ bool QuickJSNativeValue::IsCallable()
 NativeValue* QuickJSNativeValue::ToBoolean()
 {
     bool cValue = JS_ToBool(engine_->GetContext(), value_);
-    return new QuickJSNativeBoolean(engine_, cValue);
+    return engine_->CreateBoolean(cValue);
 }
 
 NativeValue* QuickJSNativeValue::ToNumber()
 {
     double cValue = 0;
     JS_ToFloat64(engine_->GetContext(), &cValue, value_);
-    return new QuickJSNativeNumber(engine_, cValue);
+    return new (engine_) QuickJSNativeNumber(engine_, cValue);
 }
 
 NativeValue* QuickJSNativeValue::ToString()
@@ -148,6 +166,16 @@ NativeValue* QuickJSNativeValue::ToObject()
     return nullptr;
 }
 
+NativeValue* QuickJSNativeValue::Duplicate()
+{
+    JSValue value = JS_DupValue(engine_->GetContext(), value_);
+    if (JS_IsObject(value)) {
+        return new (engine_) QuickJSNativeValue(engine_, value);
+    }
+    // Primitives are told apart by tag alone, and map back to the engine's singletons.
+    return QuickJSNativeEngine::JSValueToNativeValue(engine_, value);
+}
+
 bool QuickJSNativeValue::operator==(NativeValue* value)
 {
     return JS_StrictEquals(engine_->GetContext(), value_, *value);
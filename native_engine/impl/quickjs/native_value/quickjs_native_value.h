@@ -26,6 +26,11 @@ public:
     QuickJSNativeValue(QuickJSNativeEngine* engine, JSValue value);
     virtual ~QuickJSNativeValue();
 
+    // Values are constructed in place in a handle of the engine's current scope.
+    static void* operator new(size_t size, QuickJSNativeEngine* engine);
+    static void operator delete(void* ptr, QuickJSNativeEngine* engine);
+    static void operator delete(void* ptr);
+
     virtual void* GetInterface(int interfaceId) override;
 
     virtual NativeValueType TypeOf() override;
@@ -44,6 +49,7 @@ public:
     virtual NativeValue* ToNumber() override;
     virtual NativeValue* ToString() override;
     virtual NativeValue* ToObject() override;
+    virtual NativeValue* Duplicate() override;
 
     virtual bool operator==(NativeValue* value) override;
 
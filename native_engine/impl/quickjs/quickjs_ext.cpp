@@ -17,26 +17,244 @@
 
 #include "native_engine/native_value.h"
 
+#include <algorithm>
 #include <string.h>
+#include <vector>
 
+// Opaque of External and BaseClass objects, the only allocation behind an External or a
+// wrapped object. It comes from the runtime allocator so JS_ComputeMemoryUsage accounts for
+// it. Records with native set are finalized through callback with their engine, the others
+// through finalizer with their context. A type tag set before the object is wrapped keeps
+// the record alive with a null data.
 struct JSObjectInfo {
-    JSContext* context = nullptr;
-    JSFinalizer finalizer = nullptr;
-    void* data = nullptr;
-    void* hint = nullptr;
+    union {
+        JSContext* context;
+        NativeEngine* engine;
+    };
+    union {
+        JSFinalizer finalizer;
+        NativeFinalize callback;
+    };
+    void* data;
+    void* hint;
+    NativeTypeTag tag;
+    bool tagged;
+    bool native;
 };
 
-JSClassID g_baseClassId = 1;
+namespace {
+JSObjectInfo* NewObjectInfo(JSContext* context, void* data, void* hint)
+{
+    auto info = reinterpret_cast<JSObjectInfo*>(js_mallocz(context, sizeof(JSObjectInfo)));
+    if (info != nullptr) {
+        info->data = data;
+        info->hint = hint;
+    }
+    return info;
+}
+
+// Opaque of BaseClass objects that hold no record, so that JS_GetOpaque finds every BaseClass
+// object. It is shared and never written to.
+JSObjectInfo g_emptyObjectInfo;
+
+void FinalizeObjectInfo(JSRuntime* runtime, JSObjectInfo* info)
+{
+    if (info == nullptr || info == &g_emptyObjectInfo) {
+        return;
+    }
+    if (!info->native && info->finalizer != nullptr) {
+        info->finalizer(info->context, info->data, info->hint);
+    } else if (info->native && info->data != nullptr && info->callback != nullptr) {
+        info->callback(info->engine, info->data, info->hint);
+    }
+    js_free_rt(runtime, info);
+}
+} // namespace
+
+JSClassID g_baseClassId = 0;
+JSClassID g_externalClassId = 0;
+
+namespace {
+// Strict equality evaluated by QuickJS itself, for the values compared here by neither tag
+// nor pointer.
+bool ScriptStrictEquals(JSContext* context, JSValue v1, JSValue v2)
+{
+    JSValue thisVar = JS_UNDEFINED;
+    JSValue argv[2] = { v1, v2 };
+    const char script[] = "(v1, v2) => v1 === v2;";
+    JSValue func = JS_Eval(context, script, strlen(script), "<input>", JS_EVAL_TYPE_GLOBAL);
+    JSValue ret = JS_Call(context, func, thisVar, 2, (JSValue*)&argv);
+    bool result = JS_ToBool(context, ret);
+    JS_FreeValue(context, func);
+    JS_FreeValue(context, ret);
+
+    return result;
+}
+
+// Strings are compared through their UTF-8 conversion, which maps each string to a distinct
+// byte sequence. ASCII strings are not copied to convert them.
+bool StringEquals(JSContext* context, JSValue v1, JSValue v2)
+{
+    if (JS_VALUE_GET_PTR(v1) == JS_VALUE_GET_PTR(v2)) {
+        return true;
+    }
+
+    size_t length1 = 0;
+    size_t length2 = 0;
+    const char* str1 = JS_ToCStringLen(context, &length1, v1);
+    const char* str2 = JS_ToCStringLen(context, &length2, v2);
+    bool result =
+        (str1 != nullptr) && (str2 != nullptr) && (length1 == length2) && (memcmp(str1, str2, length1) == 0);
+    JS_FreeCString(context, str1);
+    JS_FreeCString(context, str2);
+    return result;
+}
+
+// Length of the leading run of ASCII bytes, tested eight bytes at a time.
+size_t AsciiPrefixLength(const uint8_t* data, size_t length)
+{
+    constexpr uint64_t highBits = 0x8080808080808080ULL;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, sizeof(word));
+        if ((word & highBits) != 0) {
+            break;
+        }
+    }
+    while (i < length && data[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+// Length of the leading run of 16 bit units below 0x80, tested four units at a time.
+size_t AsciiPrefixLength(const uint16_t* data, size_t length)
+{
+    constexpr uint64_t highBits = 0xFF80FF80FF80FF80ULL;
+    constexpr size_t unitsPerWord = sizeof(uint64_t) / sizeof(uint16_t);
+    size_t i = 0;
+    for (; i + unitsPerWord <= length; i += unitsPerWord) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, sizeof(word));
+        if ((word & highBits) != 0) {
+            break;
+        }
+    }
+    while (i < length && data[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+size_t EncodeLatin1ToUtf8(const uint8_t* data, uint32_t length, char* buffer, size_t bufferSize, uint32_t* count)
+{
+    size_t pos = 0;
+    uint32_t i = 0;
+    while (i < length) {
+        size_t run = AsciiPrefixLength(data + i, std::min<size_t>(length - i, bufferSize - pos));
+        memcpy(buffer + pos, data + i, run);
+        pos += run;
+        i += run;
+        if (i == length || bufferSize - pos < 2) {
+            break;
+        }
+        buffer[pos++] = (char)(0xC0 | (data[i] >> 6));
+        buffer[pos++] = (char)(0x80 | (data[i] & 0x3F));
+        i++;
+    }
+    *count = i;
+    return pos;
+}
+
+size_t EncodeUtf16ToUtf8(const uint16_t* data, uint32_t length, char* buffer, size_t bufferSize, uint32_t* count)
+{
+    size_t pos = 0;
+    uint32_t i = 0;
+    while (i < length) {
+        uint32_t codePoint = data[i];
+        uint32_t units = 1;
+        if (codePoint < 0x80) {
+            if (pos == bufferSize) {
+                break;
+            }
+            buffer[pos++] = (char)codePoint;
+            i++;
+            continue;
+        }
+        if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 1 < length && data[i + 1] >= 0xDC00 &&
+            data[i + 1] < 0xE000) {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (data[i + 1] - 0xDC00);
+            units = 2;
+        }
+        // Lone surrogates are written as three byte sequences, as JS_ToCStringLen does.
+        size_t size = (codePoint < 0x800) ? 2 : ((codePoint < 0x10000) ? 3 : 4);
+        if (bufferSize - pos < size) {
+            break;
+        }
+        if (size == 2) {
+            buffer[pos++] = (char)(0xC0 | (codePoint >> 6));
+        } else if (size == 3) {
+            buffer[pos++] = (char)(0xE0 | (codePoint >> 12));
+            buffer[pos++] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        } else {
+            buffer[pos++] = (char)(0xF0 | (codePoint >> 18));
+            buffer[pos++] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+            buffer[pos++] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        }
+        buffer[pos++] = (char)(0x80 | (codePoint & 0x3F));
+        i += units;
+    }
+    *count = i;
+    return pos;
+}
+
+// Strings up to this many UTF-8 bytes are encoded on the stack.
+constexpr size_t STRING_STACK_BUFFER_SIZE = 256;
+
+template<typename T>
+using EncodeToUtf8 = size_t (*)(const T* data, uint32_t length, char* buffer, size_t bufferSize, uint32_t* count);
+
+// QuickJS creates strings from UTF-8 only. The input is encoded into a buffer on the stack
+// when it fits, so only long strings allocate a temporary copy.
+template<typename T>
+JSValue NewStringFromEncoding(
+    JSContext* context, const T* data, size_t length, size_t maxBytesPerUnit, EncodeToUtf8<T> encode)
+{
+    char stackBuffer[STRING_STACK_BUFFER_SIZE];
+    std::vector<char> heapBuffer;
+    char* buffer = stackBuffer;
+    size_t bufferSize = length * maxBytesPerUnit;
+    if (bufferSize > sizeof(stackBuffer)) {
+        heapBuffer.resize(bufferSize);
+        buffer = heapBuffer.data();
+    }
+    uint32_t count = 0;
+    size_t written = encode(data, length, buffer, bufferSize, &count);
+    return JS_NewStringLen(context, buffer, written);
+}
+} // namespace
 
 void AddIntrinsicExternal(JSContext* context)
 {
     const char* className = "External";
+    const JSClassDef externalClassDef = {
+        .class_name = className,
+        .finalizer =
+            [](JSRuntime* rt, JSValue val) {
+                FinalizeObjectInfo(rt, reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(val, GetExternalClassID())));
+            },
+    };
+
+    JS_NewClassID(&g_externalClassId);
+    JS_NewClass(JS_GetRuntime(context), g_externalClassId, &externalClassDef);
+
     JSValue global = JS_GetGlobalObject(context);
     JSValue external = JS_NewCFunction2(
         context,
         [](JSContext* ctx, JSValueConst newTarget, int argc, JSValueConst* argv) {
             JSValue proto = JS_GetPropertyStr(ctx, newTarget, "prototype");
-            JSValue result = JS_NewObjectProtoClass(ctx, proto, GetBaseClassID());
+            JSValue result = JS_NewObjectProtoClass(ctx, proto, GetExternalClassID());
             JS_FreeValue(ctx, proto);
             return result;
         },
@@ -46,9 +264,11 @@ void AddIntrinsicExternal(JSContext* context)
     JS_DefinePropertyValueStr(context, external, "prototype", JS_DupValue(context, proto), 0);
     JS_DefinePropertyValueStr(context, proto, "constructor", JS_DupValue(context, external),
                               JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
+    // Externals take the class prototype, so the global binding is only there for scripts and
+    // is read-only to keep External.prototype reachable under its name.
+    JS_SetClassProto(context, g_externalClassId, proto);
 
-    JS_SetPropertyStr(context, global, "External", external);
-    JS_FreeValue(context, proto);
+    JS_DefinePropertyValueStr(context, global, className, external, 0);
     JS_FreeValue(context, global);
 }
 
@@ -57,41 +277,59 @@ JSClassID GetBaseClassID()
     return g_baseClassId;
 }
 
+JSClassID GetExternalClassID()
+{
+    return g_externalClassId;
+}
+
 JSValue JS_NewExternal(JSContext* context, void* value, JSFinalizer finalizer, void* hint)
 {
-    JSValue global = JS_GetGlobalObject(context);
-    JSValue external = JS_GetPropertyStr(context, global, "External");
-    JSValue result = JS_CallConstructor(context, external, 0, nullptr);
+    JSValue result = JS_NewObjectClass(context, GetExternalClassID());
 
-    auto info = new JSObjectInfo();
+    if (JS_IsException(result)) {
+        return result;
+    }
+    // Externals are told apart by their record, so none is created without one.
+    JSObjectInfo* info = NewObjectInfo(context, value, hint);
+    if (info == nullptr) {
+        JS_FreeValue(context, result);
+        return JS_EXCEPTION;
+    }
     info->context = context;
     info->finalizer = finalizer;
-    info->data = value;
-    info->hint = hint;
     JS_SetOpaque(result, info);
+    return result;
+}
 
-    JS_FreeValue(context, external);
-    JS_FreeValue(context, global);
+JSValue JS_NewNativeExternal(JSContext* context, NativeEngine* engine, void* value, NativeFinalize callback,
+                             void* hint)
+{
+    JSValue result = JS_NewObjectClass(context, GetExternalClassID());
+
+    if (JS_IsException(result)) {
+        return result;
+    }
+    JSObjectInfo* info = NewObjectInfo(context, value, hint);
+    if (info == nullptr) {
+        JS_FreeValue(context, result);
+        return JS_EXCEPTION;
+    }
+    info->engine = engine;
+    info->callback = callback;
+    info->native = true;
+    JS_SetOpaque(result, info);
     return result;
 }
 
 void* JS_ExternalToNativeObject(JSContext* context, JSValue value)
 {
-    auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(value, GetBaseClassID()));
+    auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(value, GetExternalClassID()));
     return (info != nullptr) ? info->data : nullptr;
 }
 
 bool JS_IsExternal(JSContext* context, JSValue value)
 {
-    bool result = false;
-    JSValue constructor = JS_GetPropertyStr(context, value, "constructor");
-    JSValue name = JS_GetPropertyStr(context, constructor, "name");
-    const char* cName = JS_ToCString(context, name);
-    result = !strcmp("External", cName ? cName : "");
-    JS_FreeCString(context, cName);
-    JS_FreeValue(context, name);
-    JS_FreeValue(context, constructor);
-    return result;
+    return JS_GetOpaque(value, GetExternalClassID()) != nullptr;
 }
 
 void AddIntrinsicBaseClass(JSContext* context)
@@ -100,11 +338,7 @@ void AddIntrinsicBaseClass(JSContext* context)
         .class_name = "BaseClass",
         .finalizer =
             [](JSRuntime* rt, JSValue val) {
-                auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(val, GetBaseClassID()));
-                if (info != nullptr) {
-                    info->finalizer(info->context, info->data, info->hint);
-                    delete info;
-                }
+                FinalizeObjectInfo(rt, reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(val, GetBaseClassID())));
             },
     };
 
@@ -112,21 +346,57 @@ void AddIntrinsicBaseClass(JSContext* context)
     JS_NewClass(JS_GetRuntime(context), g_baseClassId, &baseClassDef);
 }
 
-void JS_SetNativePointer(JSContext* context, JSValue value, void* pointer, JSFinalizer finalizer, void* hint)
+JSValue JS_NewBaseClassObject(JSContext* context, JSValue proto)
 {
+    JSValue result = JS_NewObjectProtoClass(context, proto, GetBaseClassID());
+    JS_SetOpaque(result, &g_emptyObjectInfo);
+    return result;
+}
+
+bool JS_SetNativePointer(JSContext* context,
+                         JSValue value,
+                         NativeEngine* engine,
+                         void* pointer,
+                         NativeFinalize callback,
+                         void* hint)
+{
+    // Only BaseClass objects keep their opaque to themselves, and all of them have one.
     auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(value, GetBaseClassID()));
     if (info == nullptr) {
-        info = new JSObjectInfo();
-        info->context = context;
-        info->finalizer = finalizer;
+        return pointer == nullptr;
+    }
+    if (pointer == nullptr) {
+        // Removing the pointer does not finalize it. The type tag stays with the object.
+        if (info->tagged) {
+            info->data = nullptr;
+            info->callback = nullptr;
+            info->hint = nullptr;
+        } else if (info != &g_emptyObjectInfo) {
+            JS_SetOpaque(value, &g_emptyObjectInfo);
+            js_free(context, info);
+        }
+        return true;
+    }
+    if (info != &g_emptyObjectInfo) {
+        if (info->data != nullptr) {
+            return false;
+        }
         info->data = pointer;
         info->hint = hint;
-    } else if (pointer == nullptr) {
-        delete info;
-        info = nullptr;
+        info->engine = engine;
+        info->callback = callback;
+        return true;
     }
 
+    info = NewObjectInfo(context, pointer, hint);
+    if (info == nullptr) {
+        return false;
+    }
+    info->engine = engine;
+    info->callback = callback;
+    info->native = true;
     JS_SetOpaque(value, info);
+    return true;
 }
 
 void* JS_GetNativePointer(JSContext* context, JSValue value)
@@ -135,87 +405,95 @@ void* JS_GetNativePointer(JSContext* context, JSValue value)
     return (info != nullptr) ? info->data : nullptr;
 }
 
-bool JS_IsPromise(JSContext* context, JSValue value)
+void* JS_GetNativePointerTagged(JSContext* context, JSValue value, const NativeTypeTag* tag)
 {
-    bool result = false;
-    JSValue constructor = JS_GetPropertyStr(context, value, "constructor");
-    JSValue name = JS_GetPropertyStr(context, constructor, "name");
-    const char* cName = JS_ToCString(context, name);
-    result = !strcmp("Promise", cName ? cName : "");
-    JS_FreeCString(context, cName);
-    JS_FreeValue(context, name);
-    JS_FreeValue(context, constructor);
-    return result;
+    auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(value, GetBaseClassID()));
+    if (info == nullptr || !info->tagged) {
+        return nullptr;
+    }
+    return (info->tag.lower == tag->lower && info->tag.upper == tag->upper) ? info->data : nullptr;
 }
 
-bool JS_IsArrayBuffer(JSContext* context, JSValue value)
+bool JS_SetTypeTag(JSContext* context, JSValue value, const NativeTypeTag* tag)
 {
-    bool result = false;
-    JSValue constructor = JS_GetPropertyStr(context, value, "constructor");
-    JSValue name = JS_GetPropertyStr(context, constructor, "name");
-    const char* cName = JS_ToCString(context, name);
-    result = !strcmp("ArrayBuffer", cName ? cName : "");
-    JS_FreeCString(context, cName);
-    JS_FreeValue(context, name);
-    JS_FreeValue(context, constructor);
-    return result;
+    auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(value, GetBaseClassID()));
+    if (info == nullptr) {
+        return false;
+    }
+    if (info == &g_emptyObjectInfo) {
+        info = NewObjectInfo(context, nullptr, nullptr);
+        if (info == nullptr) {
+            return false;
+        }
+        info->native = true;
+        JS_SetOpaque(value, info);
+    } else if (info->tagged) {
+        return false;
+    }
+    info->tag = *tag;
+    info->tagged = true;
+    return true;
 }
 
-bool JS_IsDate(JSContext* context, JSValue value)
+bool JS_CheckTypeTag(JSContext* context, JSValue value, const NativeTypeTag* tag)
 {
-    bool result = false;
-    JSValue constructor = JS_GetPropertyStr(context, value, "constructor");
-    JSValue name = JS_GetPropertyStr(context, constructor, "name");
-    const char* cName = JS_ToCString(context, name);
-    result = !strcmp("Date", cName ? cName : "");
-    JS_FreeCString(context, cName);
-    JS_FreeValue(context, name);
-    JS_FreeValue(context, constructor);
-    return result;
+    auto* info = reinterpret_cast<JSObjectInfo*>(JS_GetOpaque(value, GetBaseClassID()));
+    return (info != nullptr) && info->tagged && info->tag.lower == tag->lower && info->tag.upper == tag->upper;
 }
 
-bool JS_IsDataView(JSContext* context, JSValue value)
+bool JS_StrictEquals(JSContext* context, JSValue v1, JSValue v2)
 {
-    bool result = false;
-    JSValue constructor = JS_GetPropertyStr(context, value, "constructor");
-    JSValue name = JS_GetPropertyStr(context, constructor, "name");
-    const char* cName = JS_ToCString(context, name);
-    result = !strcmp("DataView", cName ? cName : "");
-    JS_FreeCString(context, cName);
-    JS_FreeValue(context, name);
-    JS_FreeValue(context, constructor);
-    return result;
+    int tag1 = JS_VALUE_GET_NORM_TAG(v1);
+    int tag2 = JS_VALUE_GET_NORM_TAG(v2);
+    if (tag1 == JS_TAG_INT && tag2 == JS_TAG_INT) {
+        return JS_VALUE_GET_INT(v1) == JS_VALUE_GET_INT(v2);
+    }
+    if (JS_IsNumber(v1) && JS_IsNumber(v2)) {
+        // NaN is not equal to itself and +0 equals -0, as the double comparison does.
+        double d1 = (tag1 == JS_TAG_INT) ? JS_VALUE_GET_INT(v1) : JS_VALUE_GET_FLOAT64(v1);
+        double d2 = (tag2 == JS_TAG_INT) ? JS_VALUE_GET_INT(v2) : JS_VALUE_GET_FLOAT64(v2);
+        return d1 == d2;
+    }
+    if (tag1 != tag2) {
+        return false;
+    }
+
+    switch (tag1) {
+        case JS_TAG_BOOL:
+            return JS_VALUE_GET_BOOL(v1) == JS_VALUE_GET_BOOL(v2);
+        case JS_TAG_NULL:
+        case JS_TAG_UNDEFINED:
+            return true;
+        case JS_TAG_STRING:
+            return StringEquals(context, v1, v2);
+        case JS_TAG_SYMBOL:
+        case JS_TAG_OBJECT:
+            return JS_VALUE_GET_PTR(v1) == JS_VALUE_GET_PTR(v2);
+        case JS_TAG_BIG_INT:
+        case JS_TAG_BIG_FLOAT:
+        case JS_TAG_BIG_DECIMAL:
+            // Big numbers are rare here. Their NaN, signed zero and precision rules are left to QuickJS.
+            return ScriptStrictEquals(context, v1, v2);
+        default:
+            return false;
+    }
 }
 
-bool JS_IsTypedArray(JSContext* context, JSValue value)
+JSValue JS_NewStringLatin1(JSContext* context, const char* str, size_t length)
 {
-    bool result = false;
-    JSValue constructor = JS_GetPropertyStr(context, value, "constructor");
-    JSValue name = JS_GetPropertyStr(context, constructor, "name");
-    const char* cName = JS_ToCString(context, name);
-    result = !strcmp("Uint8ClampedArray", cName ? cName : "") || !strcmp("Int8Array", cName ? cName : "") ||
-             !strcmp("Uint8Array", cName ? cName : "") || !strcmp("Int16Array", cName ? cName : "") ||
-             !strcmp("Uint16Array", cName ? cName : "") || !strcmp("Int32Array", cName ? cName : "") ||
-             !strcmp("Uint32Array", cName ? cName : "") || !strcmp("BigInt64Array", cName ? cName : "") ||
-             !strcmp("BigUint64Array", cName ? cName : "") || !strcmp("Float32Array", cName ? cName : "") ||
-             !strcmp("Float64Array", cName ? cName : "");
+    auto data = reinterpret_cast<const uint8_t*>(str);
+    if (AsciiPrefixLength(data, length) == length) {
+        return JS_NewStringLen(context, str, length);
+    }
 
-    JS_FreeCString(context, cName);
-    JS_FreeValue(context, name);
-    JS_FreeValue(context, constructor);
-    return result;
+    // Latin-1 characters take at most two bytes in UTF-8, which QuickJS stores back as 8 bit.
+    constexpr size_t maxBytesPerUnit = 2;
+    return NewStringFromEncoding<uint8_t>(context, data, length, maxBytesPerUnit, EncodeLatin1ToUtf8);
 }
 
-bool JS_StrictEquals(JSContext* context, JSValue v1, JSValue v2)
+JSValue JS_NewStringUtf16(JSContext* context, const uint16_t* str, size_t length)
 {
-    JSValue thisVar = JS_UNDEFINED;
-    JSValue argv[2] = { v1, v2 };
-    const char script[] = "(v1, v2) => v1 === v2;";
-    JSValue func = JS_Eval(context, script, strlen(script), "<input>", JS_EVAL_TYPE_GLOBAL);
-    JSValue ret = JS_Call(context, func, thisVar, 2, (JSValue*)&argv);
-    bool result = JS_ToBool(context, ret);
-    JS_FreeValue(context, func);
-    JS_FreeValue(context, ret);
-
-    return result;
-}
\ No newline at end of file
+    // ASCII units take one byte in UTF-8, any other unit at most three.
+    size_t maxBytesPerUnit = (AsciiPrefixLength(str, length) == length) ? 1 : 3;
+    return NewStringFromEncoding<uint16_t>(context, str, length, maxBytesPerUnit, EncodeUtf16ToUtf8);
+}
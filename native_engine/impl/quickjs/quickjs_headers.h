@@ -21,25 +21,46 @@ extern "C" {
 #include "quickjs-libc.h"
 }
 
+#include "native_engine/native_value.h"
+
 typedef void (*JSFinalizer)(JSContext* context, void* data, void* hint);
 
 JSClassID GetBaseClassID();
+JSClassID GetExternalClassID();
 
 void AddIntrinsicBaseClass(JSContext* context);
 void AddIntrinsicExternal(JSContext* context);
 
+// Creates an object of the BaseClass, the only class that can wrap a native pointer.
+JSValue JS_NewBaseClassObject(JSContext* context, JSValue proto);
+
+// Externals are objects of their own class, created with the class prototype and finalized
+// with their context, or with their engine when created by JS_NewNativeExternal.
 JSValue JS_NewExternal(JSContext* context, void* value, JSFinalizer finalizer, void* hint);
+JSValue JS_NewNativeExternal(JSContext* context, NativeEngine* engine, void* value, NativeFinalize callback,
+                             void* hint);
 void* JS_ExternalToNativeObject(JSContext* context, JSValue value);
 bool JS_IsExternal(JSContext* context, JSValue value);
 
-void JS_SetNativePointer(JSContext* context, JSValue value, void* pointer, JSFinalizer finalizer, void* hint);
+// Wraps pointer into a BaseClass object, or unwraps it without finalizing when pointer is null.
+// Fails when the object already wraps a pointer or can not hold one.
+bool JS_SetNativePointer(JSContext* context,
+                         JSValue value,
+                         NativeEngine* engine,
+                         void* pointer,
+                         NativeFinalize callback,
+                         void* hint);
 void* JS_GetNativePointer(JSContext* context, JSValue value);
+// Returns the wrapped pointer only when the object carries tag, or null otherwise.
+void* JS_GetNativePointerTagged(JSContext* context, JSValue value, const NativeTypeTag* tag);
+// Tags a BaseClass object once, stored next to its wrapped pointer. Fails when the object is
+// already tagged or can not hold one.
+bool JS_SetTypeTag(JSContext* context, JSValue value, const NativeTypeTag* tag);
+bool JS_CheckTypeTag(JSContext* context, JSValue value, const NativeTypeTag* tag);
 
-bool JS_IsPromise(JSContext* context, JSValue value);
-bool JS_IsArrayBuffer(JSContext* context, JSValue value);
-bool JS_IsDate(JSContext* context, JSValue value);
-bool JS_IsDataView(JSContext* context, JSValue value);
-bool JS_IsTypedArray(JSContext* context, JSValue value);
 bool JS_StrictEquals(JSContext* context, JSValue v1, JSValue v2);
 
+JSValue JS_NewStringLatin1(JSContext* context, const char* str, size_t length);
+JSValue JS_NewStringUtf16(JSContext* context, const uint16_t* str, size_t length);
+
 #endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_HEADERS_H */
@@ -28,6 +28,8 @@
 #include "native_value/quickjs_native_string.h"
 #include "native_value/quickjs_native_typed_array.h"
 #include "quickjs_native_deferred.h"
+#include "quickjs_native_object_template.h"
+#include "quickjs_native_prepared_call.h"
 #include "quickjs_native_reference.h"
 #include "securec.h"
 
@@ -37,6 +39,130 @@
 const int JS_WRITE_OBJ = (1 << 2) | (1 << 3);
 const int JS_ATOM_MESSAGE = 51;
 
+static const char* const ATOM_NAMES[QUICKJS_ATOM_MAX] = {
+    "length", "byteLength", "byteOffset", "buffer", "prototype",
+};
+
+namespace {
+// Arguments unwrapped for a QuickJS call. Short argument lists stay on the stack.
+class QuickJSArguments {
+public:
+    QuickJSArguments(NativeValue* const* argv, size_t argc)
+        : values_((argc > QUICKJS_INLINE_ARGC) ? new JSValue[argc] : inlineValues_)
+    {
+        for (size_t i = 0; i < argc; i++) {
+            values_[i] = (argv[i] != nullptr) ? (JSValue)*argv[i] : JS_UNDEFINED;
+        }
+    }
+
+    ~QuickJSArguments()
+    {
+        if (values_ != inlineValues_) {
+            delete[] values_;
+        }
+    }
+
+    JSValue* Get()
+    {
+        return values_;
+    }
+
+private:
+    JSValue inlineValues_[QUICKJS_INLINE_ARGC];
+    JSValue* values_;
+};
+
+// Per class state of DefineClass, owned through an External in the first data slot of the
+// class constructor. The second slot holds the class prototype.
+struct QuickJSClassInfo {
+    NativeFunctionInfo functionInfo;
+    // Not owned, the constructor outlives the data it carries.
+    void* constructor = nullptr;
+};
+
+constexpr int CLASS_DATA_INFO = 0;
+constexpr int CLASS_DATA_PROTOTYPE = 1;
+constexpr int CLASS_DATA_COUNT = 2;
+
+JSValue ClassConstructorCallback(JSContext* ctx,
+                                 JSValueConst newTarget,
+                                 int argc,
+                                 JSValueConst* argv,
+                                 int magic,
+                                 JSValue* funcData)
+{
+    auto classInfo = (QuickJSClassInfo*)JS_ExternalToNativeObject(ctx, funcData[CLASS_DATA_INFO]);
+    if (classInfo == nullptr) {
+        HILOG_ERROR("classInfo is nullptr");
+        return JS_UNDEFINED;
+    }
+    if (!JS_IsObject(newTarget)) {
+        return JS_ThrowTypeError(ctx, "class constructor cannot be invoked without 'new'");
+    }
+
+    auto engine = static_cast<QuickJSNativeEngine*>(classInfo->functionInfo.engine);
+    NativeScopeManager* scopeManager = engine->GetScopeManager();
+    if (scopeManager == nullptr) {
+        HILOG_ERROR("scopeManager is nullptr");
+        return JS_UNDEFINED;
+    }
+
+    // Subclasses construct through their own prototype, only the class itself uses the cached one.
+    JSValue thisVar = JS_UNDEFINED;
+    if (JS_VALUE_GET_PTR(newTarget) == classInfo->constructor) {
+        thisVar = JS_NewBaseClassObject(ctx, funcData[CLASS_DATA_PROTOTYPE]);
+    } else {
+        JSValue prototype = JS_GetProperty(ctx, newTarget, engine->GetAtom(QUICKJS_ATOM_PROTOTYPE));
+        thisVar = JS_NewBaseClassObject(ctx, prototype);
+        JS_FreeValue(ctx, prototype);
+    }
+    if (JS_IsException(thisVar)) {
+        return thisVar;
+    }
+
+    NativeScope* scope = scopeManager->Open();
+    if (scope == nullptr) {
+        HILOG_ERROR("scope is nullptr");
+        JS_FreeValue(ctx, thisVar);
+        return JS_UNDEFINED;
+    }
+
+    NativeCallbackInfo callbackInfo = {0};
+    callbackInfo.argc = argc;
+    callbackInfo.functionInfo = &classInfo->functionInfo;
+    callbackInfo.loader = QuickJSNativeFunction::LoadArgument;
+    callbackInfo.rawArgv = argv;
+    callbackInfo.rawThis = &thisVar;
+    callbackInfo.rawNewTarget = &newTarget;
+
+    NativeValue* value = classInfo->functionInfo.callback(engine, &callbackInfo);
+
+    JSValue result = JS_UNDEFINED;
+    if (value != nullptr) {
+        result = JS_DupValue(ctx, *value);
+    } else if (engine->IsExceptionPending()) {
+        NativeValue* error = engine->GetAndClearLastException();
+        if (error != nullptr) {
+            result = JS_DupValue(ctx, *error);
+        }
+    }
+
+    scopeManager->Close(scope);
+    JS_FreeValue(ctx, thisVar);
+    return result;
+}
+} // namespace
+
+static const char* const TYPED_ARRAY_NAMES[NATIVE_BIGUINT64_ARRAY + 1] = {
+    "Int8Array", "Uint8Array", "Uint8ClampedArray", "Int16Array", "Uint16Array", "Int32Array",
+    "Uint32Array", "Float32Array", "Float64Array", "BigInt64Array", "BigUint64Array",
+};
+
+// Global constructors of the intrinsic classes, except %TypedArray% which has no global name.
+static const char* const INTRINSIC_NAMES[QUICKJS_INTRINSIC_TYPED_ARRAY] = {
+    "Promise", "ArrayBuffer", "Date", "DataView",
+};
+
 QuickJSNativeEngine::QuickJSNativeEngine(JSRuntime* runtime, JSContext* context)
 {
     runtime_ = runtime;
@@ -44,6 +170,13 @@ QuickJSNativeEngine::QuickJSNativeEngine(JSRuntime* runtime, JSContext* context)
 
     AddIntrinsicBaseClass(context_);
     AddIntrinsicExternal(context_);
+    InitIntrinsics();
+
+    // Global operator new keeps these out of the scope manager.
+    undefinedValue_ = ::new QuickJSNativeValue(this, JS_UNDEFINED);
+    nullValue_ = ::new QuickJSNativeValue(this, JS_NULL);
+    trueValue_ = ::new QuickJSNativeBoolean(this, true);
+    falseValue_ = ::new QuickJSNativeBoolean(this, false);
 
     JSValue jsGlobal = JS_GetGlobalObject(context_);
     JSValue jsNativeEngine = (JSValue)JS_MKPTR(JS_TAG_INT, this);
@@ -66,7 +199,7 @@ QuickJSNativeEngine::QuickJSNativeEngine(JSRuntime* runtime, JSContext* context)
             NativeModule* module = moduleManager->LoadNativeModule(moduleName, nullptr, true);
 
             if (module != nullptr && module->registerCallback != nullptr) {
-                NativeValue* value = new QuickJSNativeObject(that);
+                NativeValue* value = new (that) QuickJSNativeObject(that);
                 if (value != nullptr) {
                     module->registerCallback(that, value);
                     result = JS_DupValue(that->GetContext(), *value);
@@ -110,7 +243,7 @@ QuickJSNativeEngine::QuickJSNativeEngine(JSRuntime* runtime, JSContext* context)
                     HILOG_ERROR("load module succ");
                 } else if (module->registerCallback != nullptr) {
                     HILOG_INFO("load napi module");
-                    NativeValue* value = new QuickJSNativeObject(that);
+                    NativeValue* value = new (that) QuickJSNativeObject(that);
                     module->registerCallback(that, value);
                     result = JS_DupValue(that->GetContext(), *value);
                 } else {
@@ -127,7 +260,20 @@ QuickJSNativeEngine::QuickJSNativeEngine(JSRuntime* runtime, JSContext* context)
     JS_FreeValue(context_, jsGlobal);
 }
 
-QuickJSNativeEngine::~QuickJSNativeEngine() {}
+QuickJSNativeEngine::~QuickJSNativeEngine()
+{
+    for (auto& propertyKey : propertyKeys_) {
+        JS_FreeAtom(context_, propertyKey.first);
+    }
+    ReleaseIntrinsics();
+    delete undefinedValue_;
+    delete nullValue_;
+    delete trueValue_;
+    delete falseValue_;
+    for (NativeValue* value : smallIntegers_) {
+        delete value;
+    }
+}
 
 JSRuntime* QuickJSNativeEngine::GetRuntime()
 {
@@ -139,6 +285,115 @@ JSContext* QuickJSNativeEngine::GetContext()
     return context_;
 }
 
+JSAtom QuickJSNativeEngine::GetAtom(QuickJSAtomType type)
+{
+    return atoms_[type];
+}
+
+JSValue QuickJSNativeEngine::GetDataViewConstructor()
+{
+    return dataViewConstructor_;
+}
+
+JSValue QuickJSNativeEngine::GetTypedArrayConstructor(NativeTypedArrayType type)
+{
+    return typedArrayConstructors_[type];
+}
+
+QuickJSIntrinsicType QuickJSNativeEngine::GetIntrinsicType(JSValue value)
+{
+    return (QuickJSIntrinsicType)FindPrototype(value, intrinsicPrototypes_, QUICKJS_INTRINSIC_MAX);
+}
+
+bool QuickJSNativeEngine::GetTypedArrayType(JSValue value, NativeTypedArrayType* type)
+{
+    int index = FindPrototype(value, typedArrayPrototypes_, NATIVE_BIGUINT64_ARRAY + 1);
+    if (index > NATIVE_BIGUINT64_ARRAY) {
+        return false;
+    }
+    *type = (NativeTypedArrayType)index;
+    return true;
+}
+
+int QuickJSNativeEngine::FindPrototype(JSValue value, const JSValue* prototypes, int count)
+{
+    if (!JS_IsObject(value)) {
+        return count;
+    }
+
+    int result = count;
+    JSValue current = JS_GetPrototype(context_, value);
+    while (result == count && JS_IsObject(current)) {
+        for (int i = 0; i < count; i++) {
+            if (JS_VALUE_GET_PTR(current) == JS_VALUE_GET_PTR(prototypes[i])) {
+                result = i;
+                break;
+            }
+        }
+        JSValue prototype = JS_GetPrototype(context_, current);
+        JS_FreeValue(context_, current);
+        current = prototype;
+    }
+    JS_FreeValue(context_, current);
+    return result;
+}
+
+void QuickJSNativeEngine::InitIntrinsics()
+{
+    for (int i = 0; i < QUICKJS_ATOM_MAX; i++) {
+        atoms_[i] = JS_NewAtom(context_, ATOM_NAMES[i]);
+    }
+
+    JSValue global = JS_GetGlobalObject(context_);
+    symbolConstructor_ = JS_GetPropertyStr(context_, global, "Symbol");
+    dataViewConstructor_ = JS_GetPropertyStr(context_, global, "DataView");
+
+    for (int i = 0; i <= NATIVE_BIGUINT64_ARRAY; i++) {
+        typedArrayConstructors_[i] = JS_GetPropertyStr(context_, global, TYPED_ARRAY_NAMES[i]);
+        typedArrayPrototypes_[i] = JS_UNDEFINED;
+        if (JS_IsConstructor(context_, typedArrayConstructors_[i])) {
+            typedArrayPrototypes_[i] =
+                JS_GetProperty(context_, typedArrayConstructors_[i], atoms_[QUICKJS_ATOM_PROTOTYPE]);
+        }
+    }
+
+    // Taken before any script runs, so later changes to the globals are not trusted.
+    for (int i = 0; i < QUICKJS_INTRINSIC_TYPED_ARRAY; i++) {
+        JSValue constructor = JS_GetPropertyStr(context_, global, INTRINSIC_NAMES[i]);
+        intrinsicPrototypes_[i] = JS_UNDEFINED;
+        if (JS_IsConstructor(context_, constructor)) {
+            intrinsicPrototypes_[i] = JS_GetProperty(context_, constructor, atoms_[QUICKJS_ATOM_PROTOTYPE]);
+        }
+        JS_FreeValue(context_, constructor);
+    }
+    // Typed arrays all inherit from the prototype of %TypedArray%.
+    intrinsicPrototypes_[QUICKJS_INTRINSIC_TYPED_ARRAY] =
+        JS_GetPrototype(context_, typedArrayPrototypes_[NATIVE_UINT8_ARRAY]);
+    JS_FreeValue(context_, global);
+}
+
+void QuickJSNativeEngine::ReleaseIntrinsics()
+{
+    for (int i = 0; i < QUICKJS_ATOM_MAX; i++) {
+        JS_FreeAtom(context_, atoms_[i]);
+        atoms_[i] = JS_ATOM_NULL;
+    }
+    for (int i = 0; i <= NATIVE_BIGUINT64_ARRAY; i++) {
+        JS_FreeValue(context_, typedArrayConstructors_[i]);
+        JS_FreeValue(context_, typedArrayPrototypes_[i]);
+        typedArrayConstructors_[i] = JS_UNDEFINED;
+        typedArrayPrototypes_[i] = JS_UNDEFINED;
+    }
+    for (int i = 0; i < QUICKJS_INTRINSIC_MAX; i++) {
+        JS_FreeValue(context_, intrinsicPrototypes_[i]);
+        intrinsicPrototypes_[i] = JS_UNDEFINED;
+    }
+    JS_FreeValue(context_, symbolConstructor_);
+    JS_FreeValue(context_, dataViewConstructor_);
+    symbolConstructor_ = JS_UNDEFINED;
+    dataViewConstructor_ = JS_UNDEFINED;
+}
+
 void QuickJSNativeEngine::Loop(LoopMode mode)
 {
     JSContext* context = nullptr;
@@ -152,99 +407,138 @@ void QuickJSNativeEngine::Loop(LoopMode mode)
 NativeValue* QuickJSNativeEngine::GetGlobal()
 {
     JSValue value = JS_GetGlobalObject(context_);
-    return new QuickJSNativeObject(this, value);
+    return new (this) QuickJSNativeObject(this, value);
 }
 
 NativeValue* QuickJSNativeEngine::CreateNull()
 {
-    return new QuickJSNativeValue(this, JS_NULL);
+    return nullValue_;
 }
 
 NativeValue* QuickJSNativeEngine::CreateUndefined()
 {
-    return new QuickJSNativeValue(this, JS_UNDEFINED);
+    return undefinedValue_;
 }
 
 NativeValue* QuickJSNativeEngine::CreateBoolean(bool value)
 {
-    return new QuickJSNativeBoolean(this, value);
+    return value ? trueValue_ : falseValue_;
 }
 
 NativeValue* QuickJSNativeEngine::CreateNumber(int32_t value)
 {
-    return new QuickJSNativeNumber(this, value);
+    NativeValue* result = GetSmallInteger(value);
+    return (result != nullptr) ? result : new (this) QuickJSNativeNumber(this, value);
 }
 
 NativeValue* QuickJSNativeEngine::CreateNumber(uint32_t value)
 {
-    return new QuickJSNativeNumber(this, value);
+    if (value <= SMALL_INTEGER_MAX) {
+        return GetSmallInteger((int32_t)value);
+    }
+    return new (this) QuickJSNativeNumber(this, value);
 }
 
 NativeValue* QuickJSNativeEngine::CreateNumber(int64_t value)
 {
-    return new QuickJSNativeNumber(this, value);
+    if (value >= SMALL_INTEGER_MIN && value <= SMALL_INTEGER_MAX) {
+        return GetSmallInteger((int32_t)value);
+    }
+    return new (this) QuickJSNativeNumber(this, value);
 }
 
 NativeValue* QuickJSNativeEngine::CreateNumber(double value)
 {
-    return new QuickJSNativeNumber(this, value);
+    return new (this) QuickJSNativeNumber(this, value);
 }
 
 NativeValue* QuickJSNativeEngine::CreateString(const char* value, size_t length)
 {
-    return new QuickJSNativeString(this, value, length);
+    return new (this) QuickJSNativeString(this, value, length);
 }
 
-NativeValue* QuickJSNativeEngine::CreateSymbol(NativeValue* value)
+NativeValue* QuickJSNativeEngine::CreateStringLatin1(const char* value, size_t length)
 {
-    JSValue symbol = { 0 };
+    return new (this) QuickJSNativeString(this, JS_NewStringLatin1(context_, value, length));
+}
 
-    JSValue global = JS_GetGlobalObject(context_);
-    JSValue symbolCotr = JS_GetPropertyStr(context_, global, "Symbol");
+NativeValue* QuickJSNativeEngine::CreateStringUtf16(const char16_t* value, size_t length)
+{
+    return new (this) QuickJSNativeString(this,
+        JS_NewStringUtf16(context_, reinterpret_cast<const uint16_t*>(value), length));
+}
 
-    JSValue jsValue = *value;
+const NativePropertyKey* QuickJSNativeEngine::CreatePropertyKey(const char* name, size_t length)
+{
+    JSAtom atom = JS_NewAtomLen(context_, name, length);
+    if (atom == JS_ATOM_NULL) {
+        return nullptr;
+    }
 
-    symbol = JS_Call(context_, symbolCotr, global, 1, &jsValue);
+    auto result = propertyKeys_.emplace(atom, NativePropertyKey { this, atom });
+    if (!result.second) {
+        // Already interned, the key keeps the reference taken the first time.
+        JS_FreeAtom(context_, atom);
+    }
+    return &result.first->second;
+}
 
-    JS_FreeValue(context_, symbolCotr);
-    JS_FreeValue(context_, global);
+NativeValue* QuickJSNativeEngine::CreateSymbol(NativeValue* value)
+{
+    JSValue jsValue = *value;
+    JSValue symbol = JS_Call(context_, symbolConstructor_, JS_UNDEFINED, 1, &jsValue);
 
-    return new QuickJSNativeValue(this, symbol);
+    return new (this) QuickJSNativeValue(this, symbol);
 }
 
 NativeValue* QuickJSNativeEngine::CreateFunction(const char* name, size_t length, NativeCallback cb, void* value)
 {
-    return new QuickJSNativeFunction(this, name, cb, value);
+    return new (this) QuickJSNativeFunction(this, name, cb, value);
+}
+
+NativeValue* QuickJSNativeEngine::CreateFunction(const NativeFunctionTemplate* functionTemplate)
+{
+    return new (this) QuickJSNativeFunction(this, functionTemplate);
 }
 
 NativeValue* QuickJSNativeEngine::CreateExternal(void* value, NativeFinalize callback, void* hint)
 {
-    return new QuickJSNativeExternal(this, value, callback, hint);
+    return new (this) QuickJSNativeExternal(this, value, callback, hint);
 }
 
 NativeValue* QuickJSNativeEngine::CreateObject()
 {
-    return new QuickJSNativeObject(this);
+    return new (this) QuickJSNativeObject(this);
 }
 
 NativeValue* QuickJSNativeEngine::CreateArrayBuffer(void** value, size_t length)
 {
-    return new QuickJSNativeArrayBuffer(this, (uint8_t**)value, length);
+    return new (this) QuickJSNativeArrayBuffer(this, (uint8_t**)value, length);
 }
 
 NativeValue* QuickJSNativeEngine::CreateArrayBufferExternal(void* value, size_t length, NativeFinalize cb, void* hint)
 {
-    return new QuickJSNativeArrayBuffer(this, (uint8_t*)value, length, cb, hint);
+    return new (this) QuickJSNativeArrayBuffer(this, (uint8_t*)value, length, cb, hint);
 }
 
 NativeValue* QuickJSNativeEngine::CreateArray(size_t length)
 {
-    return new QuickJSNativeArray(this, length);
+    return new (this) QuickJSNativeArray(this, length);
+}
+
+NativeValue* QuickJSNativeEngine::CreateArrayWithElements(NativeValue* const* values, size_t count)
+{
+    return new (this) QuickJSNativeArray(this, values, count);
+}
+
+NativeValue* QuickJSNativeEngine::CreateArrayFromNumbers(NativeTypedArrayType type, const void* data, size_t length)
+{
+    return new (this) QuickJSNativeArray(this, type, data, length);
 }
 
 NativeValue* QuickJSNativeEngine::CreateDataView(NativeValue* value, size_t length, size_t offset)
 {
-    return new QuickJSNativeDataView(this, value, length, offset);
+    return new (this) QuickJSNativeDataView(this, value, length, offset);
 }
 
 NativeValue* QuickJSNativeEngine::CreateTypedArray(NativeTypedArrayType type,
@@ -252,7 +546,7 @@ NativeValue* QuickJSNativeEngine::CreateTypedArray(NativeTypedArrayType type,
                                                    size_t length,
                                                    size_t offset)
 {
-    return new QuickJSNativeTypedArray(this, type, value, length, offset);
+    return new (this) QuickJSNativeTypedArray(this, type, value, length, offset);
 }
 
 NativeValue* QuickJSNativeEngine::CreatePromise(NativeDeferred** deferred)
@@ -261,7 +555,7 @@ NativeValue* QuickJSNativeEngine::CreatePromise(NativeDeferred** deferred)
     JSValue resolvingFuncs[2] = { 0 };
     promise = JS_NewPromiseCapability(context_, resolvingFuncs);
     *deferred = new QuickJSNativeDeferred(this, resolvingFuncs);
-    return new QuickJSNativeValue(this, promise);
+    return new (this) QuickJSNativeValue(this, promise);
 }
 
 NativeValue* QuickJSNativeEngine::CreateError(NativeValue* code, NativeValue* message)
@@ -274,23 +568,13 @@ NativeValue* QuickJSNativeEngine::CreateError(NativeValue* code, NativeValue* me
         JS_SetPropertyStr(context_, error, "message", JS_DupValue(context_, *message));
     }
 
-    return new QuickJSNativeObject(this, error);
+    return new (this) QuickJSNativeObject(this, error);
 }
 
 NativeValue* QuickJSNativeEngine::CreateInstance(NativeValue* constructor, NativeValue* const* argv, size_t argc)
 {
-    JSValue result = JS_UNDEFINED;
-    JSValue* params = nullptr;
-    if (argc > 0) {
-        params = new JSValue[argc];
-        for (size_t i = 0; i < argc; i++) {
-            params[i] = *argv[i];
-        }
-    }
-    result = JS_CallConstructor(context_, *constructor, argc, params);
-    if (params != nullptr) {
-        delete[] params;
-    }
+    QuickJSArguments params(argv, argc);
+    JSValue result = JS_CallConstructor(context_, *constructor, argc, params.Get());
     return QuickJSNativeEngine::JSValueToNativeValue(this, result);
 }
 
@@ -299,6 +583,16 @@ NativeReference* QuickJSNativeEngine::CreateReference(NativeValue* value, uint32
     return new QuickJSNativeReference(this, value, initialRefcount);
 }
 
+NativePreparedCall* QuickJSNativeEngine::PrepareCall(NativeValue* thisVar, NativeValue* function, size_t argc)
+{
+    return new QuickJSNativePreparedCall(this, thisVar, function, argc);
+}
+
+NativeObjectTemplate* QuickJSNativeEngine::CreateObjectTemplate(const char* const* names, size_t count)
+{
+    return new QuickJSNativeObjectTemplate(this, names, count);
+}
+
 NativeValue* QuickJSNativeEngine::CallFunction(NativeValue* thisVar,
                                                NativeValue* function,
                                                NativeValue* const* argv,
@@ -307,37 +601,25 @@ NativeValue* QuickJSNativeEngine::CallFunction(NativeValue* thisVar,
     JSValue result = JS_UNDEFINED;
 
     if (function == nullptr) {
-        return new QuickJSNativeValue(this, JS_UNDEFINED);
+        return CreateUndefined();
     }
 
     NativeScope* scope = scopeManager_->Open();
     if (scope == nullptr) {
         HILOG_ERROR("Open scope failed");
-        return new QuickJSNativeValue(this, JS_UNDEFINED);
-    }
-
-    JSValue* args = nullptr;
-    if (argc > 0) {
-        args = new JSValue[argc];
-        for (size_t i = 0; i < argc; i++) {
-            if (argv[i] != nullptr) {
-                args[i] = *argv[i];
-            } else {
-                args[i] = JS_UNDEFINED;
-            }
-        }
+        return CreateUndefined();
     }
 
-    result = JS_Call(context_, *function, (thisVar != nullptr) ? (JSValue)*thisVar : JS_UNDEFINED, argc, args);
-    JS_DupValue(context_, result);
-
-    if (args != nullptr) {
-        delete []args;
-    }
+    QuickJSArguments args(argv, argc);
+    result = JS_Call(context_, *function, (thisVar != nullptr) ? (JSValue)*thisVar : JS_UNDEFINED, argc, args.Get());
 
     scopeManager_->Close(scope);
 
-    if (JS_IsError(context_, result) || JS_IsException(result)) {
+    if (JS_IsException(result)) {
+        return nullptr;
+    }
+    if (JS_IsError(context_, result)) {
+        JS_FreeValue(context_, result);
         return nullptr;
     }
 
@@ -397,81 +679,29 @@ NativeValue* QuickJSNativeEngine::DefineClass(const char* name,
                                               const NativePropertyDescriptor* properties,
                                               size_t length)
 {
-    NativeFunctionInfo* functionInfo = new NativeFunctionInfo();
-    if (functionInfo == nullptr) {
-        HILOG_ERROR("new NativeFunctionInfo failed");
-        return nullptr;
-    }
-    functionInfo->engine = this;
-    functionInfo->data = data;
-    functionInfo->callback = callback;
-
-    JSValue classConstructor = JS_NewCFunction2(
-        context_,
-        [](JSContext* ctx, JSValueConst newTarget, int argc, JSValueConst* argv) -> JSValue {
-            auto callbackInfo = new NativeCallbackInfo();
-            JSValue prototype = JS_GetPropertyStr(ctx, newTarget, "prototype");
-            JSValue classContext = JS_GetPropertyStr(ctx, newTarget, "_classContext");
-
-            auto functionInfo = (NativeFunctionInfo*)JS_ExternalToNativeObject(ctx, classContext);
-            if (functionInfo == nullptr) {
-                HILOG_ERROR("functionInfo is nullptr");
-                return JS_UNDEFINED;
-            }
-
-            QuickJSNativeEngine* engine = (QuickJSNativeEngine*)functionInfo->engine;
-            NativeScopeManager* scopeManager = engine->GetScopeManager();
-            if (scopeManager == nullptr) {
-                HILOG_ERROR("scopeManager is nullptr");
-                return JS_UNDEFINED;
-            }
-
-            NativeScope* scope = scopeManager->Open();
-            if (scope == nullptr) {
-                HILOG_ERROR("scope is nullptr");
-                return JS_UNDEFINED;
-            }
-
-            callbackInfo->argc = argc;
-            callbackInfo->argv = nullptr;
-            callbackInfo->function = JSValueToNativeValue(engine, JS_DupValue(ctx, newTarget));
-            callbackInfo->functionInfo = functionInfo;
-            callbackInfo->thisVar =
-                JSValueToNativeValue(engine, JS_NewObjectProtoClass(ctx, prototype, GetBaseClassID()));
-
-            if (callbackInfo->argc > 0) {
-                callbackInfo->argv = new NativeValue*[argc];
-                for (size_t i = 0; i < callbackInfo->argc; i++) {
-                    callbackInfo->argv[i] = JSValueToNativeValue(engine, JS_DupValue(ctx, argv[i]));
-                }
-            }
-
-            NativeValue* value = functionInfo->callback(engine, callbackInfo);
-
-            if (callbackInfo != nullptr) {
-                delete callbackInfo->argv;
-            }
+    auto classInfo = new QuickJSClassInfo();
+    classInfo->functionInfo.engine = this;
+    classInfo->functionInfo.data = data;
+    classInfo->functionInfo.callback = callback;
 
-            JSValue result = JS_UNDEFINED;
-            if (value != nullptr) {
-                result = JS_DupValue(ctx, *value);
-            } else if (engine->IsExceptionPending()) {
-                NativeValue* error = engine->GetAndClearLastException();
-                if (error != nullptr) {
-                    result = JS_DupValue(ctx, *error);
-                }
-            }
-
-            delete callbackInfo;
-            scopeManager->Close(scope);
-
-            return result;
-        },
-        name, 0, JS_CFUNC_constructor_or_func, 0);
     JSValue proto = JS_NewObject(context_);
-
-    QuickJSNativeObject* nativeClass = new QuickJSNativeObject(this, JS_DupValue(context_, classConstructor));
-    QuickJSNativeObject* nativeClassProto = new QuickJSNativeObject(this, proto);
+    JSValue classData[CLASS_DATA_COUNT];
+    classData[CLASS_DATA_INFO] = JS_NewExternal(context_, classInfo,
+                                                [](JSContext* ctx, void* data, void* hint) {
+                                                    delete (QuickJSClassInfo*)data;
+                                                }, nullptr);
+    classData[CLASS_DATA_PROTOTYPE] = proto;
+    JSValue classConstructor =
+        JS_NewCFunctionData(context_, ClassConstructorCallback, 0, 0, CLASS_DATA_COUNT, classData);
+    // The constructor keeps its own references to the data.
+    JS_FreeValue(context_, classData[CLASS_DATA_INFO]);
+    classInfo->constructor = JS_VALUE_GET_PTR(classConstructor);
+
+    JS_SetConstructorBit(context_, classConstructor, true);
+    JS_DefinePropertyValueStr(context_, classConstructor, "name", JS_NewString(context_, name), JS_PROP_CONFIGURABLE);
+
+    QuickJSNativeObject* nativeClass = new (this) QuickJSNativeObject(this, classConstructor);
+    QuickJSNativeObject* nativeClassProto = new (this) QuickJSNativeObject(this, proto);
 
     for (size_t i = 0; i < length; i++) {
         if (properties[i].attributes & NATIVE_STATIC) {
@@ -481,17 +711,8 @@ NativeValue* QuickJSNativeEngine::DefineClass(const char* name,
         }
     }
 
-    JS_DefinePropertyValueStr(context_, *nativeClass, "prototype", JS_DupValue(context_, *nativeClassProto), 0);
-
-    JSValue classContext = JS_NewExternal(context_, functionInfo,
-                                          [](JSContext* ctx, void* data, void* hint) {
-                                              auto info = (NativeFunctionInfo*)data;
-                                              HILOG_INFO("_classContext Destroy");
-                                              if (info != nullptr) {
-                                                  delete info;
-                                              }
-                                          }, nullptr);
-    JS_DefinePropertyValueStr(context_, *nativeClass, "_classContext", classContext, 0);
+    JS_DefinePropertyValue(context_, *nativeClass, atoms_[QUICKJS_ATOM_PROTOTYPE],
+                           JS_DupValue(context_, *nativeClassProto), 0);
 
     JS_DefinePropertyValueStr(context_, *nativeClassProto, "constructor", JS_DupValue(context_, *nativeClass),
                               JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
@@ -519,59 +740,81 @@ bool QuickJSNativeEngine::Throw(NativeErrorType type, const char* code, const ch
         default:
             error = JS_ThrowInternalError(context_, "code: %s, message: %s\n", code, message);
     }
-    this->lastException_ = new QuickJSNativeValue(this, error);
+    this->lastException_ = new (this) QuickJSNativeValue(this, error);
     return true;
 }
 
+NativeValue* QuickJSNativeEngine::GetSmallInteger(int32_t value)
+{
+    if (value < SMALL_INTEGER_MIN || value > SMALL_INTEGER_MAX) {
+        return nullptr;
+    }
+    NativeValue*& result = smallIntegers_[value - SMALL_INTEGER_MIN];
+    if (result == nullptr) {
+        result = ::new QuickJSNativeNumber(this, value);
+    }
+    return result;
+}
+
 NativeValue* QuickJSNativeEngine::JSValueToNativeValue(QuickJSNativeEngine* engine, JSValue value)
 {
     NativeValue* result = nullptr;
+    QuickJSIntrinsicType intrinsicType = QUICKJS_INTRINSIC_MAX;
     int tag = JS_VALUE_GET_NORM_TAG(value);
     switch (tag) {
         case JS_TAG_BIG_INT:
         case JS_TAG_BIG_FLOAT:
-            result = new QuickJSNativeObject(engine, value);
+            result = new (engine) QuickJSNativeObject(engine, value);
             break;
         case JS_TAG_SYMBOL:
-            result = new QuickJSNativeValue(engine, value);
+            result = new (engine) QuickJSNativeValue(engine, value);
             break;
         case JS_TAG_STRING:
-            result = new QuickJSNativeString(engine, value);
+            result = new (engine) QuickJSNativeString(engine, value);
             break;
         case JS_TAG_OBJECT:
             if (JS_IsArray(engine->GetContext(), value)) {
-                result = new QuickJSNativeArray(engine, value);
+                result = new (engine) QuickJSNativeArray(engine, value);
             } else if (JS_IsError(engine->GetContext(), value)) {
-                result = new QuickJSNativeValue(engine, value);
-            } else if (JS_IsPromise(engine->GetContext(), value)) {
-                result = new QuickJSNativeValue(engine, value);
-            } else if (JS_IsArrayBuffer(engine->GetContext(), value)) {
-                result = new QuickJSNativeArrayBuffer(engine, value);
-            } else if (JS_IsDataView(engine->GetContext(), value)) {
-                result = new QuickJSNativeDataView(engine, value);
-            } else if (JS_IsTypedArray(engine->GetContext(), value)) {
-                result = new QuickJSNativeTypedArray(engine, value);
+                result = new (engine) QuickJSNativeValue(engine, value);
+            } else if ((intrinsicType = engine->GetIntrinsicType(value)) == QUICKJS_INTRINSIC_PROMISE) {
+                result = new (engine) QuickJSNativeValue(engine, value);
+            } else if (intrinsicType == QUICKJS_INTRINSIC_ARRAY_BUFFER) {
+                result = new (engine) QuickJSNativeArrayBuffer(engine, value);
+            } else if (intrinsicType == QUICKJS_INTRINSIC_DATA_VIEW) {
+                result = new (engine) QuickJSNativeDataView(engine, value);
+            } else if (intrinsicType == QUICKJS_INTRINSIC_TYPED_ARRAY) {
+                result = new (engine) QuickJSNativeTypedArray(engine, value);
             } else if (JS_IsExternal(engine->GetContext(), value)) {
-                result = new QuickJSNativeExternal(engine, value);
+                result = new (engine) QuickJSNativeExternal(engine, value);
             } else if (JS_IsFunction(engine->GetContext(), value)) {
-                result = new QuickJSNativeFunction(engine, value);
+                result = new (engine) QuickJSNativeFunction(engine, value);
             } else {
-                result = new QuickJSNativeObject(engine, value);
+                result = new (engine) QuickJSNativeObject(engine, value);
             }
             break;
         case JS_TAG_BOOL:
-            result = new QuickJSNativeBoolean(engine, value);
+            result = engine->CreateBoolean(JS_VALUE_GET_BOOL(value));
             break;
         case JS_TAG_NULL:
+            result = engine->CreateNull();
+            break;
         case JS_TAG_UNDEFINED:
+            result = engine->CreateUndefined();
+            break;
         case JS_TAG_UNINITIALIZED:
         case JS_TAG_CATCH_OFFSET:
         case JS_TAG_EXCEPTION:
-            result = new QuickJSNativeValue(engine, value);
+            result = new (engine) QuickJSNativeValue(engine, value);
             break;
         case JS_TAG_INT:
+            result = engine->GetSmallInteger(JS_VALUE_GET_INT(value));
+            if (result == nullptr) {
+                result = new (engine) QuickJSNativeNumber(engine, value);
+            }
+            break;
         case JS_TAG_FLOAT64:
-            result = new QuickJSNativeNumber(engine, value);
+            result = new (engine) QuickJSNativeNumber(engine, value);
             break;
         default:
             HILOG_DEBUG("JS_VALUE_GET_NORM_TAG %{public}d", tag);
@@ -610,7 +853,7 @@ bool QuickJSNativeEngine::CheckTransferList(JSValue transferList)
     for (int64_t i = 0; i < len; i++) {
         JSValue tmp = JS_GetPropertyInt64(context_, transferList, i);
         if (!JS_IsException(tmp)) {
-            if (!JS_IsArrayBuffer(context_, tmp)) {
+            if (GetIntrinsicType(tmp) != QUICKJS_INTRINSIC_ARRAY_BUFFER) {
                 HILOG_ERROR("JS_ISArrayBuffer fail");
                 return false;
             }
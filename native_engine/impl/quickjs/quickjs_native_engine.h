@@ -16,6 +16,8 @@
 #ifndef FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_ENGINE_H
 #define FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_ENGINE_H
 
+#include <unordered_map>
+
 #include "native_engine/native_engine.h"
 #include "quickjs_headers.h"
 
@@ -45,6 +47,28 @@ private:
     std::unique_ptr<uint8_t, Deleter> value_;
 };
 
+// Calls with up to this many arguments pass them from the stack instead of the heap.
+constexpr size_t QUICKJS_INLINE_ARGC = 8;
+
+enum QuickJSAtomType {
+    QUICKJS_ATOM_LENGTH,
+    QUICKJS_ATOM_BYTE_LENGTH,
+    QUICKJS_ATOM_BYTE_OFFSET,
+    QUICKJS_ATOM_BUFFER,
+    QUICKJS_ATOM_PROTOTYPE,
+    QUICKJS_ATOM_MAX,
+};
+
+// Intrinsic classes told apart by their prototype, since QuickJS exports no class id.
+enum QuickJSIntrinsicType {
+    QUICKJS_INTRINSIC_PROMISE,
+    QUICKJS_INTRINSIC_ARRAY_BUFFER,
+    QUICKJS_INTRINSIC_DATE,
+    QUICKJS_INTRINSIC_DATA_VIEW,
+    QUICKJS_INTRINSIC_TYPED_ARRAY,
+    QUICKJS_INTRINSIC_MAX,
+};
+
 class QuickJSNativeEngine : public NativeEngine {
 public:
     QuickJSNativeEngine(JSRuntime* runtime, JSContext* context);
@@ -53,6 +77,18 @@ public:
     JSRuntime* GetRuntime();
     JSContext* GetContext();
 
+    // Intrinsics resolved once when the engine is created. The values are borrowed.
+    JSAtom GetAtom(QuickJSAtomType type);
+    JSValue GetDataViewConstructor();
+    JSValue GetTypedArrayConstructor(NativeTypedArrayType type);
+
+    // Class of value found from the prototypes it inherits from, so instances of subclasses
+    // are classified with their base class. QUICKJS_INTRINSIC_MAX is returned for any other
+    // value. The result only changes when the prototype chain is changed.
+    QuickJSIntrinsicType GetIntrinsicType(JSValue value);
+    // Type of a typed array, found the same way. Returns false when value is not one.
+    bool GetTypedArrayType(JSValue value, NativeTypedArrayType* type);
+
     virtual void Loop(LoopMode mode) override;
 
     virtual NativeValue* GetGlobal() override;
@@ -64,13 +100,19 @@ public:
     virtual NativeValue* CreateNumber(int64_t value) override;
     virtual NativeValue* CreateNumber(double value) override;
     virtual NativeValue* CreateString(const char* value, size_t length) override;
+    virtual NativeValue* CreateStringLatin1(const char* value, size_t length) override;
+    virtual NativeValue* CreateStringUtf16(const char16_t* value, size_t length) override;
+    virtual const NativePropertyKey* CreatePropertyKey(const char* name, size_t length) override;
 
     virtual NativeValue* CreateSymbol(NativeValue* value) override;
     virtual NativeValue* CreateExternal(void* value, NativeFinalize callback, void* hint) override;
 
     virtual NativeValue* CreateObject() override;
     virtual NativeValue* CreateFunction(const char* name, size_t length, NativeCallback cb, void* value) override;
+    virtual NativeValue* CreateFunction(const NativeFunctionTemplate* functionTemplate) override;
     virtual NativeValue* CreateArray(size_t length) override;
+    virtual NativeValue* CreateArrayWithElements(NativeValue* const* values, size_t count) override;
+    virtual NativeValue* CreateArrayFromNumbers(NativeTypedArrayType type, const void* data, size_t length) override;
 
     virtual NativeValue* CreateArrayBuffer(void** value, size_t length) override;
     virtual NativeValue* CreateArrayBufferExternal(void* value, size_t length, NativeFinalize cb, void* hint) override;
@@ -86,6 +128,8 @@ public:
     virtual NativeValue* CreateInstance(NativeValue* constructor, NativeValue* const* argv, size_t argc) override;
 
     virtual NativeReference* CreateReference(NativeValue* value, uint32_t initialRefcount) override;
+    virtual NativePreparedCall* PrepareCall(NativeValue* thisVar, NativeValue* function, size_t argc) override;
+    virtual NativeObjectTemplate* CreateObjectTemplate(const char* const* names, size_t count) override;
 
     virtual NativeValue* CallFunction(NativeValue* thisVar,
                                       NativeValue* function,
@@ -116,8 +160,33 @@ public:
     static NativeValue* JSValueToNativeValue(QuickJSNativeEngine* engine, JSValue value);
 
 private:
+    static constexpr int32_t SMALL_INTEGER_MIN = -128;
+    static constexpr int32_t SMALL_INTEGER_MAX = 255;
+
+    NativeValue* GetSmallInteger(int32_t value);
+    void InitIntrinsics();
+    void ReleaseIntrinsics();
+    int FindPrototype(JSValue value, const JSValue* prototypes, int count);
+
     JSRuntime* runtime_;
     JSContext* context_;
+
+    JSAtom atoms_[QUICKJS_ATOM_MAX] = { JS_ATOM_NULL };
+    JSValue symbolConstructor_ = JS_UNDEFINED;
+    JSValue dataViewConstructor_ = JS_UNDEFINED;
+    JSValue typedArrayConstructors_[NATIVE_BIGUINT64_ARRAY + 1];
+    JSValue typedArrayPrototypes_[NATIVE_BIGUINT64_ARRAY + 1];
+    JSValue intrinsicPrototypes_[QUICKJS_INTRINSIC_MAX];
+
+    // Interned property keys by atom. Each atom holds one reference until the engine is destroyed.
+    std::unordered_map<JSAtom, NativePropertyKey> propertyKeys_;
+
+    // Immortal values owned by the engine. They are not registered with any scope.
+    NativeValue* undefinedValue_ { nullptr };
+    NativeValue* nullValue_ { nullptr };
+    NativeValue* trueValue_ { nullptr };
+    NativeValue* falseValue_ { nullptr };
+    NativeValue* smallIntegers_[SMALL_INTEGER_MAX - SMALL_INTEGER_MIN + 1] = { nullptr };
 };
 
 #endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_ENGINE_H */
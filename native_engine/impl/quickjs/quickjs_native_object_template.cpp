@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "quickjs_native_object_template.h"
+
+#include "native_value/quickjs_native_object.h"
+
+QuickJSNativeObjectTemplate::QuickJSNativeObjectTemplate(QuickJSNativeEngine* engine,
+                                                         const char* const* names,
+                                                         size_t count)
+{
+    JSContext* context = engine->GetContext();
+    engine_ = engine;
+    atoms_.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        atoms_.push_back(JS_NewAtom(context, names[i]));
+    }
+}
+
+QuickJSNativeObjectTemplate::~QuickJSNativeObjectTemplate()
+{
+    JSContext* context = engine_->GetContext();
+    for (JSAtom atom : atoms_) {
+        JS_FreeAtom(context, atom);
+    }
+}
+
+NativeEngine* QuickJSNativeObjectTemplate::GetEngine()
+{
+    return engine_;
+}
+
+size_t QuickJSNativeObjectTemplate::GetFieldCount()
+{
+    return atoms_.size();
+}
+
+NativeValue* QuickJSNativeObjectTemplate::CreateInstance(NativeValue* const* values)
+{
+    // Instances built in the same order walk the same shape transitions, which QuickJS shares
+    // between objects, so only the first instance creates shapes.
+    JSValue object = JS_NewObject(engine_->GetContext());
+    if (!DefineValues(object, values)) {
+        JS_FreeValue(engine_->GetContext(), object);
+        return nullptr;
+    }
+    return new (engine_) QuickJSNativeObject(engine_, object);
+}
+
+bool QuickJSNativeObjectTemplate::DefineFields(NativeValue* object, NativeValue* const* values)
+{
+    return DefineValues(*object, values);
+}
+
+bool QuickJSNativeObjectTemplate::DefineValues(JSValue object, NativeValue* const* values)
+{
+    JSContext* context = engine_->GetContext();
+    for (size_t i = 0; i < atoms_.size(); i++) {
+        JSValue value = (values[i] != nullptr) ? JS_DupValue(context, *values[i]) : JS_UNDEFINED;
+        if (JS_DefinePropertyValue(context, object, atoms_[i], value, JS_PROP_C_W_E) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_OBJECT_TEMPLATE_H
+#define FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_OBJECT_TEMPLATE_H
+
+#include <vector>
+
+#include "native_engine/native_object_template.h"
+
+#include "quickjs_native_engine.h"
+
+class QuickJSNativeObjectTemplate : public NativeObjectTemplate {
+public:
+    QuickJSNativeObjectTemplate(QuickJSNativeEngine* engine, const char* const* names, size_t count);
+    virtual ~QuickJSNativeObjectTemplate();
+
+    virtual NativeEngine* GetEngine() override;
+    virtual size_t GetFieldCount() override;
+    virtual NativeValue* CreateInstance(NativeValue* const* values) override;
+    virtual bool DefineFields(NativeValue* object, NativeValue* const* values) override;
+
+private:
+    bool DefineValues(JSValue object, NativeValue* const* values);
+
+    QuickJSNativeEngine* engine_;
+    std::vector<JSAtom> atoms_;
+};
+
+#endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_OBJECT_TEMPLATE_H */
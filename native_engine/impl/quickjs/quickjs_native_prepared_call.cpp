@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "quickjs_native_prepared_call.h"
+
+QuickJSNativePreparedCall::QuickJSNativePreparedCall(QuickJSNativeEngine* engine,
+                                                     NativeValue* thisVar,
+                                                     NativeValue* function,
+                                                     size_t argc)
+{
+    JSContext* context = engine->GetContext();
+    engine_ = engine;
+    thisVar_ = (thisVar != nullptr) ? JS_DupValue(context, *thisVar) : JS_UNDEFINED;
+    function_ = JS_DupValue(context, *function);
+    argc_ = argc;
+    argv_ = (argc > QUICKJS_INLINE_ARGC) ? new JSValue[argc] : inlineArgv_;
+    callDepth_ = 0;
+    released_ = false;
+    for (size_t i = 0; i < argc_; i++) {
+        argv_[i] = JS_UNDEFINED;
+    }
+}
+
+QuickJSNativePreparedCall::~QuickJSNativePreparedCall()
+{
+    JSContext* context = engine_->GetContext();
+    for (size_t i = 0; i < argc_; i++) {
+        JS_FreeValue(context, argv_[i]);
+    }
+    if (argv_ != inlineArgv_) {
+        delete[] argv_;
+    }
+    JS_FreeValue(context, function_);
+    JS_FreeValue(context, thisVar_);
+}
+
+NativeEngine* QuickJSNativePreparedCall::GetEngine()
+{
+    return engine_;
+}
+
+size_t QuickJSNativePreparedCall::GetArgc()
+{
+    return argc_;
+}
+
+bool QuickJSNativePreparedCall::SetArgument(size_t index, NativeValue* value)
+{
+    // A running callee may still hold the current arguments without a reference of its own.
+    if (index >= argc_ || callDepth_ > 0) {
+        return false;
+    }
+
+    JSContext* context = engine_->GetContext();
+    JSValue previous = argv_[index];
+    argv_[index] = (value != nullptr) ? JS_DupValue(context, *value) : JS_UNDEFINED;
+    JS_FreeValue(context, previous);
+    return true;
+}
+
+NativeValue* QuickJSNativePreparedCall::Call()
+{
+    QuickJSNativeEngine* engine = engine_;
+    JSContext* context = engine->GetContext();
+
+    callDepth_++;
+    JSValue result = JS_Call(context, function_, thisVar_, static_cast<int>(argc_), argv_);
+    callDepth_--;
+
+    // The callee released the call while it was running. Nothing of this object is used
+    // after this point.
+    if (callDepth_ == 0 && released_) {
+        delete this;
+    }
+
+    if (JS_IsException(result)) {
+        return nullptr;
+    }
+    if (JS_IsError(context, result)) {
+        JS_FreeValue(context, result);
+        return nullptr;
+    }
+    return QuickJSNativeEngine::JSValueToNativeValue(engine, result);
+}
+
+void QuickJSNativePreparedCall::Release()
+{
+    // The function and the argument frame are still in use by JS_Call.
+    if (callDepth_ > 0) {
+        released_ = true;
+        return;
+    }
+    delete this;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_PREPARED_CALL_H
+#define FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_PREPARED_CALL_H
+
+#include "native_engine/native_prepared_call.h"
+
+#include "quickjs_native_engine.h"
+
+class QuickJSNativePreparedCall : public NativePreparedCall {
+public:
+    QuickJSNativePreparedCall(QuickJSNativeEngine* engine, NativeValue* thisVar, NativeValue* function, size_t argc);
+    virtual ~QuickJSNativePreparedCall();
+
+    virtual NativeEngine* GetEngine() override;
+    virtual size_t GetArgc() override;
+    virtual bool SetArgument(size_t index, NativeValue* value) override;
+    virtual NativeValue* Call() override;
+    virtual void Release() override;
+
+private:
+    QuickJSNativeEngine* engine_;
+    JSValue thisVar_;
+    JSValue function_;
+    size_t argc_;
+    JSValue* argv_;
+    uint32_t callDepth_;
+    bool released_;
+    // Frames up to QUICKJS_INLINE_ARGC arguments live in the call object itself.
+    JSValue inlineArgv_[QUICKJS_INLINE_ARGC];
+};
+
+#endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_IMPL_QUICKJS_QUICKJS_NATIVE_PREPARED_CALL_H */
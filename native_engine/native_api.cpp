@@ -15,6 +15,8 @@
 
 #include "native_api_internal.h"
 
+#include <string>
+
 #include "native_engine/native_property.h"
 #include "native_engine/native_value.h"
 
@@ -118,6 +120,25 @@ NAPI_EXTERN napi_status napi_create_array_with_length(napi_env env, size_t lengt
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_create_array_with_elements(napi_env env,
+                                                        const napi_value* values,
+                                                        size_t count,
+                                                        napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    RETURN_STATUS_IF_FALSE(env, count == 0 || values != nullptr, napi_invalid_arg);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, values[i]);
+    }
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+    auto resultValue = engine->CreateArrayWithElements(reinterpret_cast<NativeValue* const*>(values), count);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_create_double(napi_env env, double value, napi_value* result)
 {
     CHECK_ENV(env);
@@ -173,7 +194,7 @@ NAPI_EXTERN napi_status napi_create_string_latin1(napi_env env, const char* str,
     CHECK_ARG(env, result);
 
     auto engine = reinterpret_cast<NativeEngine*>(env);
-    auto resultValue = engine->CreateString(str, (length == NAPI_AUTO_LENGTH) ? strlen(str) : length);
+    auto resultValue = engine->CreateStringLatin1(str, (length == NAPI_AUTO_LENGTH) ? strlen(str) : length);
 
     *result = reinterpret_cast<napi_value>(resultValue);
     return napi_clear_last_error(env);
@@ -192,6 +213,25 @@ NAPI_EXTERN napi_status napi_create_string_utf8(napi_env env, const char* str, s
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_create_string_utf16(napi_env env,
+                                                 const char16_t* str,
+                                                 size_t length,
+                                                 napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, str);
+    CHECK_ARG(env, result);
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+    if (length == NAPI_AUTO_LENGTH) {
+        length = std::char_traits<char16_t>::length(str);
+    }
+    auto resultValue = engine->CreateStringUtf16(str, length);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_create_symbol(napi_env env, napi_value description, napi_value* result)
 {
     CHECK_ENV(env);
@@ -231,6 +271,48 @@ NAPI_EXTERN napi_status napi_create_function(napi_env env,
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_create_function_template(napi_env env,
+                                                      napi_callback cb,
+                                                      void* data,
+                                                      napi_function_template* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, cb);
+    CHECK_ARG(env, result);
+
+    auto functionTemplate = new NativeFunctionTemplate();
+    functionTemplate->callback = reinterpret_cast<NativeCallback>(cb);
+    functionTemplate->data = data;
+
+    *result = reinterpret_cast<napi_function_template>(functionTemplate);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_create_function_from_template(napi_env env,
+                                                           napi_function_template function_template,
+                                                           napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, function_template);
+    CHECK_ARG(env, result);
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+
+    auto resultValue = engine->CreateFunction(reinterpret_cast<NativeFunctionTemplate*>(function_template));
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_delete_function_template(napi_env env, napi_function_template function_template)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, function_template);
+
+    delete reinterpret_cast<NativeFunctionTemplate*>(function_template);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_create_error(napi_env env, napi_value code, napi_value msg, napi_value* result)
 {
     CHECK_ENV(env);
@@ -391,7 +473,7 @@ napi_get_value_string_latin1(napi_env env, napi_value value, char* buf, size_t b
 
     auto nativeString = reinterpret_cast<NativeString*>(nativeValue->GetInterface(NativeString::INTERFACE_ID));
 
-    nativeString->GetCString(buf, bufsize, result);
+    nativeString->GetCStringLatin1(buf, bufsize, result);
     return napi_clear_last_error(env);
 }
 
@@ -409,7 +491,29 @@ napi_get_value_string_utf8(napi_env env, napi_value value, char* buf, size_t buf
 
     auto nativeString = reinterpret_cast<NativeString*>(nativeValue->GetInterface(NativeString::INTERFACE_ID));
 
-    nativeString->GetCString(buf, bufsize, result);
+    if (buf == nullptr) {
+        *result = nativeString->GetLength();
+    } else {
+        nativeString->GetCString(buf, bufsize, result);
+    }
+    return napi_clear_last_error(env);
+}
+
+// Copies UTF-16 encoded units from a string into a buffer.
+NAPI_EXTERN napi_status
+napi_get_value_string_utf16(napi_env env, napi_value value, char16_t* buf, size_t bufsize, size_t* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, value);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(value);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_STRING, napi_string_expected);
+
+    auto nativeString = reinterpret_cast<NativeString*>(nativeValue->GetInterface(NativeString::INTERFACE_ID));
+
+    nativeString->GetCStringUtf16(buf, bufsize, result);
     return napi_clear_last_error(env);
 }
 
@@ -508,6 +612,63 @@ NAPI_EXTERN napi_status napi_get_property_names(napi_env env, napi_value object,
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_get_all_property_names(napi_env env,
+                                                    napi_value object,
+                                                    napi_key_collection_mode key_mode,
+                                                    napi_key_filter key_filter,
+                                                    napi_key_conversion key_conversion,
+                                                    napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    auto resultValue = nativeObject->GetAllPropertyNames((NativeKeyCollectionMode)key_mode, (int)key_filter,
+                                                         (NativeKeyConversion)key_conversion);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_object_for_each(napi_env env,
+                                             napi_value object,
+                                             napi_property_iterator callback,
+                                             void* data)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, callback);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    struct IteratorContext {
+        napi_env env;
+        napi_property_iterator callback;
+        void* data;
+    } context = { env, callback, data };
+
+    bool result = nativeObject->ForEachProperty(
+        [](NativeValue* key, NativeValue* value, void* data) -> bool {
+            auto context = reinterpret_cast<IteratorContext*>(data);
+            return context->callback(context->env, reinterpret_cast<napi_value>(key),
+                                     reinterpret_cast<napi_value>(value), context->data);
+        },
+        &context);
+
+    RETURN_STATUS_IF_FALSE(env, result, napi_pending_exception);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_set_property(napi_env env, napi_value object, napi_value key, napi_value value)
 {
     CHECK_ENV(env);
@@ -657,6 +818,243 @@ NAPI_EXTERN napi_status napi_get_named_property(napi_env env,
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_get_named_properties(napi_env env,
+                                                  napi_value object,
+                                                  const napi_property_key* keys,
+                                                  size_t count,
+                                                  napi_value* results,
+                                                  bool* found)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, results);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propKeys = reinterpret_cast<const NativePropertyKey* const*>(keys);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, propKeys[i]);
+        RETURN_STATUS_IF_FALSE(env, propKeys[i]->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    }
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    RETURN_STATUS_IF_FALSE(env,
+                           nativeObject->GetProperties(propKeys, count, reinterpret_cast<NativeValue**>(results), found),
+                           napi_pending_exception);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_set_named_properties(napi_env env,
+                                                  napi_value object,
+                                                  const napi_property_key* keys,
+                                                  const napi_value* values,
+                                                  size_t count,
+                                                  bool* results)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propKeys = reinterpret_cast<const NativePropertyKey* const*>(keys);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, propKeys[i]);
+        CHECK_ARG(env, values[i]);
+        RETURN_STATUS_IF_FALSE(env, propKeys[i]->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    }
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    RETURN_STATUS_IF_FALSE(env,
+                           nativeObject->SetProperties(propKeys, reinterpret_cast<NativeValue* const*>(values), count,
+                                                       results),
+                           napi_pending_exception);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_create_property_key(napi_env env,
+                                                const char* utf8name,
+                                                size_t length,
+                                                napi_property_key* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, utf8name);
+    CHECK_ARG(env, result);
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+    auto propertyKey = engine->CreatePropertyKey(utf8name, (length == NAPI_AUTO_LENGTH) ? strlen(utf8name) : length);
+    RETURN_STATUS_IF_FALSE(env, propertyKey != nullptr, napi_generic_failure);
+
+    *result = reinterpret_cast<napi_property_key>(const_cast<NativePropertyKey*>(propertyKey));
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_set_property_by_key(napi_env env,
+                                                 napi_value object,
+                                                 napi_property_key key,
+                                                 napi_value value)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, key);
+    CHECK_ARG(env, value);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propKey = reinterpret_cast<NativePropertyKey*>(key);
+    auto propValue = reinterpret_cast<NativeValue*>(value);
+
+    RETURN_STATUS_IF_FALSE(env, propKey->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    nativeObject->SetProperty(propKey, propValue);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_get_property_by_key(napi_env env,
+                                                 napi_value object,
+                                                 napi_property_key key,
+                                                 napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, key);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propKey = reinterpret_cast<NativePropertyKey*>(key);
+
+    RETURN_STATUS_IF_FALSE(env, propKey->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    auto resultValue = nativeObject->GetProperty(propKey);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_has_property_by_key(napi_env env,
+                                                 napi_value object,
+                                                 napi_property_key key,
+                                                 bool* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, key);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propKey = reinterpret_cast<NativePropertyKey*>(key);
+
+    RETURN_STATUS_IF_FALSE(env, propKey->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    *result = nativeObject->HasProperty(propKey);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_delete_property_by_key(napi_env env,
+                                                    napi_value object,
+                                                    napi_property_key key,
+                                                    bool* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, key);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propKey = reinterpret_cast<NativePropertyKey*>(key);
+
+    RETURN_STATUS_IF_FALSE(env, propKey->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    bool deleted = nativeObject->DeleteProperty(propKey);
+    if (result != nullptr) {
+        *result = deleted;
+    }
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_create_property_cache(napi_env env, napi_property_key key, napi_property_cache* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, key);
+    CHECK_ARG(env, result);
+
+    auto propKey = reinterpret_cast<NativePropertyKey*>(key);
+    RETURN_STATUS_IF_FALSE(env, propKey->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+
+    auto cache = new NativePropertyCache();
+    cache->key = propKey;
+
+    *result = reinterpret_cast<napi_property_cache>(cache);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_delete_property_cache(napi_env env, napi_property_cache cache)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, cache);
+
+    delete reinterpret_cast<NativePropertyCache*>(cache);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_get_property_cached(napi_env env,
+                                                 napi_value object,
+                                                 napi_property_cache cache,
+                                                 napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, cache);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto propCache = reinterpret_cast<NativePropertyCache*>(cache);
+
+    RETURN_STATUS_IF_FALSE(env, propCache->key->engine == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    auto resultValue = nativeObject->GetProperty(propCache);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_get_property_cache_stats(napi_env env,
+                                                      napi_property_cache cache,
+                                                      uint64_t* hits,
+                                                      uint64_t* misses)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, cache);
+
+    auto propCache = reinterpret_cast<NativePropertyCache*>(cache);
+    if (hits != nullptr) {
+        *hits = propCache->hits;
+    }
+    if (misses != nullptr) {
+        *misses = propCache->misses;
+    }
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_set_element(napi_env env, napi_value object, uint32_t index, napi_value value)
 {
     CHECK_ENV(env);
@@ -674,6 +1072,34 @@ NAPI_EXTERN napi_status napi_set_element(napi_env env, napi_value object, uint32
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_set_elements(napi_env env,
+                                          napi_value object,
+                                          uint32_t start,
+                                          const napi_value* values,
+                                          size_t count)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    RETURN_STATUS_IF_FALSE(env, count == 0 || values != nullptr, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, count <= UINT32_MAX - start, napi_invalid_arg);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, values[i]);
+    }
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->IsArray(), napi_array_expected);
+
+    auto nativeArray = reinterpret_cast<NativeArray*>(nativeValue->GetInterface(NativeArray::INTERFACE_ID));
+
+    bool stored = true;
+    RETURN_STATUS_IF_FALSE(env,
+                           nativeArray->SetElements(start, reinterpret_cast<NativeValue* const*>(values), count, &stored),
+                           napi_pending_exception);
+    RETURN_STATUS_IF_FALSE(env, stored, napi_generic_failure);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_has_element(napi_env env, napi_value object, uint32_t index, bool* result)
 {
     CHECK_ENV(env);
@@ -708,6 +1134,29 @@ NAPI_EXTERN napi_status napi_get_element(napi_env env, napi_value object, uint32
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_get_elements(napi_env env,
+                                          napi_value object,
+                                          uint32_t start,
+                                          size_t count,
+                                          napi_value* results)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    RETURN_STATUS_IF_FALSE(env, count == 0 || results != nullptr, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, count <= UINT32_MAX - start, napi_invalid_arg);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->IsArray(), napi_array_expected);
+
+    auto nativeArray = reinterpret_cast<NativeArray*>(nativeValue->GetInterface(NativeArray::INTERFACE_ID));
+
+    RETURN_STATUS_IF_FALSE(env,
+                           nativeArray->GetElements(start, count, reinterpret_cast<NativeValue**>(results)),
+                           napi_pending_exception);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_delete_element(napi_env env, napi_value object, uint32_t index, bool* result)
 {
     CHECK_ENV(env);
@@ -836,6 +1285,159 @@ NAPI_EXTERN napi_status napi_call_function(napi_env env,
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_prepare_call(napi_env env,
+                                          napi_value recv,
+                                          napi_value func,
+                                          size_t argc,
+                                          napi_prepared_call* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, func);
+    CHECK_ARG(env, result);
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+    auto nativeRecv = reinterpret_cast<NativeValue*>(recv);
+    auto nativeFunc = reinterpret_cast<NativeValue*>(func);
+
+    RETURN_STATUS_IF_FALSE(env, nativeFunc->TypeOf() == NATIVE_FUNCTION, napi_function_expected);
+
+    auto preparedCall = engine->PrepareCall(nativeRecv, nativeFunc, argc);
+
+    *result = reinterpret_cast<napi_prepared_call>(preparedCall);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_set_prepared_call_argument(napi_env env,
+                                                        napi_prepared_call call,
+                                                        size_t index,
+                                                        napi_value value)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, call);
+    CHECK_ARG(env, value);
+
+    auto preparedCall = reinterpret_cast<NativePreparedCall*>(call);
+    auto nativeValue = reinterpret_cast<NativeValue*>(value);
+
+    RETURN_STATUS_IF_FALSE(env, preparedCall->GetEngine() == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, index < preparedCall->GetArgc(), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, preparedCall->SetArgument(index, nativeValue), napi_generic_failure);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_invoke_prepared_call(napi_env env, napi_prepared_call call, napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, call);
+
+    auto preparedCall = reinterpret_cast<NativePreparedCall*>(call);
+
+    RETURN_STATUS_IF_FALSE(env, preparedCall->GetEngine() == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+
+    auto resultValue = preparedCall->Call();
+
+    if (result != nullptr) {
+        *result = reinterpret_cast<napi_value>(resultValue);
+    }
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_delete_prepared_call(napi_env env, napi_prepared_call call)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, call);
+
+    auto preparedCall = reinterpret_cast<NativePreparedCall*>(call);
+
+    RETURN_STATUS_IF_FALSE(env, preparedCall->GetEngine() == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+
+    preparedCall->Release();
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_create_object_template(napi_env env,
+                                                   const char* const* utf8names,
+                                                   size_t count,
+                                                   napi_object_template* result)
+{
+    CHECK_ENV(env);
+    if (count > 0) {
+        CHECK_ARG(env, utf8names);
+    }
+    CHECK_ARG(env, result);
+
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, utf8names[i]);
+    }
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+
+    auto objectTemplate = engine->CreateObjectTemplate(utf8names, count);
+
+    *result = reinterpret_cast<napi_object_template>(objectTemplate);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_create_object_from_template(napi_env env,
+                                                        napi_object_template object_template,
+                                                        const napi_value* values,
+                                                        napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object_template);
+    CHECK_ARG(env, result);
+
+    auto objectTemplate = reinterpret_cast<NativeObjectTemplate*>(object_template);
+    if (objectTemplate->GetFieldCount() > 0) {
+        CHECK_ARG(env, values);
+    }
+
+    RETURN_STATUS_IF_FALSE(env, objectTemplate->GetEngine() == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+
+    auto resultValue = objectTemplate->CreateInstance(reinterpret_cast<NativeValue* const*>(values));
+
+    RETURN_STATUS_IF_FALSE(env, resultValue != nullptr, napi_generic_failure);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_define_properties_from_template(napi_env env,
+                                                            napi_value object,
+                                                            napi_object_template object_template,
+                                                            const napi_value* values)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object);
+    CHECK_ARG(env, object_template);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(object);
+    auto objectTemplate = reinterpret_cast<NativeObjectTemplate*>(object_template);
+    if (objectTemplate->GetFieldCount() > 0) {
+        CHECK_ARG(env, values);
+    }
+
+    RETURN_STATUS_IF_FALSE(env, objectTemplate->GetEngine() == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+    RETURN_STATUS_IF_FALSE(env,
+                           objectTemplate->DefineFields(nativeValue, reinterpret_cast<NativeValue* const*>(values)),
+                           napi_generic_failure);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_delete_object_template(napi_env env, napi_object_template object_template)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, object_template);
+
+    auto objectTemplate = reinterpret_cast<NativeObjectTemplate*>(object_template);
+
+    RETURN_STATUS_IF_FALSE(env, objectTemplate->GetEngine() == reinterpret_cast<NativeEngine*>(env), napi_invalid_arg);
+
+    delete objectTemplate;
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status
 napi_new_instance(napi_env env, napi_value constructor, size_t argc, const napi_value* argv, napi_value* result)
 {
@@ -894,7 +1496,7 @@ NAPI_EXTERN napi_status napi_get_cb_info(napi_env env,              // [in] NAPI
     if ((argc != nullptr) && (argv != nullptr)) {
         size_t i = 0;
         for (i = 0; (i < *argc) && (i < info->argc); i++) {
-            argv[i] = reinterpret_cast<napi_value>(info->argv[i]);
+            argv[i] = reinterpret_cast<napi_value>(info->GetArgument(i));
         }
         *argc = i;
     }
@@ -904,7 +1506,7 @@ NAPI_EXTERN napi_status napi_get_cb_info(napi_env env,              // [in] NAPI
     }
 
     if (this_arg != nullptr) {
-        *this_arg = reinterpret_cast<napi_value>(info->thisVar);
+        *this_arg = reinterpret_cast<napi_value>(info->GetThis());
     }
 
     if (data != nullptr && info->functionInfo != nullptr) {
@@ -922,8 +1524,9 @@ NAPI_EXTERN napi_status napi_get_new_target(napi_env env, napi_callback_info cbi
 
     auto info = reinterpret_cast<NativeCallbackInfo*>(cbinfo);
 
-    if (info->thisVar->InstanceOf(info->function)) {
-        *result = reinterpret_cast<napi_value>(info->function);
+    NativeValue* function = info->GetFunction();
+    if (function != nullptr && info->GetThis()->InstanceOf(function)) {
+        *result = reinterpret_cast<napi_value>(function);
     } else {
         *result = nullptr;
     }
@@ -979,7 +1582,8 @@ NAPI_EXTERN napi_status napi_wrap(napi_env env,
 
     auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
 
-    nativeObject->SetNativePointer(native_object, callback, finalize_hint);
+    RETURN_STATUS_IF_FALSE(env, nativeObject->SetNativePointer(native_object, callback, finalize_hint),
+                           napi_invalid_arg);
     return napi_clear_last_error(env);
 }
 
@@ -1018,6 +1622,63 @@ NAPI_EXTERN napi_status napi_remove_wrap(napi_env env, napi_value js_object, voi
     return napi_clear_last_error(env);
 }
 
+NAPI_EXTERN napi_status napi_type_tag_object(napi_env env, napi_value js_object, const napi_type_tag* type_tag)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, js_object);
+    CHECK_ARG(env, type_tag);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(js_object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    RETURN_STATUS_IF_FALSE(env, nativeObject->SetTypeTag(reinterpret_cast<const NativeTypeTag*>(type_tag)),
+                           napi_invalid_arg);
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_check_object_type_tag(napi_env env,
+                                                   napi_value js_object,
+                                                   const napi_type_tag* type_tag,
+                                                   bool* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, js_object);
+    CHECK_ARG(env, type_tag);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(js_object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    *result = nativeObject->CheckTypeTag(reinterpret_cast<const NativeTypeTag*>(type_tag));
+    return napi_clear_last_error(env);
+}
+
+NAPI_EXTERN napi_status napi_unwrap_tagged(napi_env env,
+                                           napi_value js_object,
+                                           const napi_type_tag* type_tag,
+                                           void** result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, js_object);
+    CHECK_ARG(env, type_tag);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(js_object);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_OBJECT, napi_object_expected);
+
+    auto nativeObject = reinterpret_cast<NativeObject*>(nativeValue->GetInterface(NativeObject::INTERFACE_ID));
+
+    *result = nativeObject->GetNativePointer(reinterpret_cast<const NativeTypeTag*>(type_tag));
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status
 napi_create_external(napi_env env, void* data, napi_finalize finalize_cb, void* finalize_hint, napi_value* result)
 {
@@ -1222,6 +1883,10 @@ NAPI_EXTERN napi_status napi_escape_handle(napi_env env,
         return napi_set_last_error(env, napi_generic_failure);
     }
 
+    if (scopeManager->IsEscapeCalled(nativeScope)) {
+        return napi_set_last_error(env, napi_escape_called_twice);
+    }
+
     auto resultValue = scopeManager->Escape(nativeScope, escapeeValue);
 
     *result = reinterpret_cast<napi_value>(resultValue);
@@ -1395,6 +2060,73 @@ NAPI_EXTERN napi_status napi_is_typedarray(napi_env env, napi_value value, bool*
     return napi_clear_last_error(env);
 }
 
+// Converts a JS array or typed array to int32, float32 or float64 numbers in one call.
+// invalid_count receives the number of non-number elements, of which the first
+// invalid_capacity indices are written to invalid_indices.
+NAPI_EXTERN napi_status napi_get_array_numbers(napi_env env,
+                                               napi_value array,
+                                               napi_typedarray_type type,
+                                               void* data,
+                                               size_t length,
+                                               uint32_t* invalid_indices,
+                                               size_t invalid_capacity,
+                                               size_t* invalid_count)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, array);
+    RETURN_STATUS_IF_FALSE(env, length == 0 || data != nullptr, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, invalid_capacity == 0 || invalid_indices != nullptr, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, length <= UINT32_MAX, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, type == napi_int32_array || type == napi_float32_array || type == napi_float64_array,
+                           napi_invalid_arg);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(array);
+    auto numberType = (NativeTypedArrayType)type;
+
+    size_t invalidCount = 0;
+    if (nativeValue->IsTypedArray()) {
+        auto nativeTypedArray =
+            reinterpret_cast<NativeTypedArray*>(nativeValue->GetInterface(NativeTypedArray::INTERFACE_ID));
+        RETURN_STATUS_IF_FALSE(env,
+                               nativeTypedArray->GetNumbers(numberType, data, length, invalid_indices,
+                                                            invalid_capacity, &invalidCount),
+                               napi_pending_exception);
+    } else {
+        RETURN_STATUS_IF_FALSE(env, nativeValue->IsArray(), napi_array_expected);
+        auto nativeArray = reinterpret_cast<NativeArray*>(nativeValue->GetInterface(NativeArray::INTERFACE_ID));
+        RETURN_STATUS_IF_FALSE(env,
+                               nativeArray->GetNumbers(numberType, data, length, invalid_indices, invalid_capacity,
+                                                       &invalidCount),
+                               napi_pending_exception);
+    }
+
+    if (invalid_count != nullptr) {
+        *invalid_count = invalidCount;
+    }
+    return napi_clear_last_error(env);
+}
+
+// Creates a JS array from int32, float32 or float64 numbers.
+NAPI_EXTERN napi_status napi_create_array_from_numbers(napi_env env,
+                                                       napi_typedarray_type type,
+                                                       const void* data,
+                                                       size_t length,
+                                                       napi_value* result)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    RETURN_STATUS_IF_FALSE(env, length == 0 || data != nullptr, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, length <= UINT32_MAX, napi_invalid_arg);
+    RETURN_STATUS_IF_FALSE(env, type == napi_int32_array || type == napi_float32_array || type == napi_float64_array,
+                           napi_invalid_arg);
+
+    auto engine = reinterpret_cast<NativeEngine*>(env);
+    auto resultValue = engine->CreateArrayFromNumbers((NativeTypedArrayType)type, data, length);
+
+    *result = reinterpret_cast<napi_value>(resultValue);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_create_typedarray(napi_env env,
                                                napi_typedarray_type type,
                                                size_t length,
@@ -1608,6 +2340,27 @@ NAPI_EXTERN napi_status napi_is_callable(napi_env env, napi_value value, bool* r
     return napi_clear_last_error(env);
 }
 
+// Returns the UTF-8 contents of a string without copying, valid until the handle scope of value closes.
+NAPI_EXTERN napi_status napi_get_value_string_utf8_view(napi_env env,
+                                                        napi_value value,
+                                                        const char** result,
+                                                        size_t* length)
+{
+    CHECK_ENV(env);
+    CHECK_ARG(env, value);
+    CHECK_ARG(env, result);
+
+    auto nativeValue = reinterpret_cast<NativeValue*>(value);
+
+    RETURN_STATUS_IF_FALSE(env, nativeValue->TypeOf() == NATIVE_STRING, napi_string_expected);
+
+    auto nativeString = reinterpret_cast<NativeString*>(nativeValue->GetInterface(NativeString::INTERFACE_ID));
+
+    *result = nativeString->GetCStringView(length);
+    RETURN_STATUS_IF_FALSE(env, *result != nullptr, napi_generic_failure);
+    return napi_clear_last_error(env);
+}
+
 NAPI_EXTERN napi_status napi_create_runtime(napi_env env, napi_env* result_env)
 {
     CHECK_ENV(env);
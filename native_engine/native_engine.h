@@ -18,6 +18,8 @@
 
 #include "native_engine/native_async_work.h"
 #include "native_engine/native_deferred.h"
+#include "native_engine/native_object_template.h"
+#include "native_engine/native_prepared_call.h"
 #include "native_engine/native_reference.h"
 #include "native_engine/native_value.h"
 #include "native_property.h"
@@ -77,13 +79,19 @@ public:
     virtual NativeValue* CreateNumber(int64_t value) = 0;
     virtual NativeValue* CreateNumber(double value) = 0;
     virtual NativeValue* CreateString(const char* value, size_t length) = 0;
+    virtual NativeValue* CreateStringLatin1(const char* value, size_t length) = 0;
+    virtual NativeValue* CreateStringUtf16(const char16_t* value, size_t length) = 0;
+    virtual const NativePropertyKey* CreatePropertyKey(const char* name, size_t length) = 0;
 
     virtual NativeValue* CreateSymbol(NativeValue* value) = 0;
     virtual NativeValue* CreateExternal(void* value, NativeFinalize callback, void* hint) = 0;
 
     virtual NativeValue* CreateObject() = 0;
     virtual NativeValue* CreateFunction(const char* name, size_t length, NativeCallback cb, void* value) = 0;
+    virtual NativeValue* CreateFunction(const NativeFunctionTemplate* functionTemplate) = 0;
     virtual NativeValue* CreateArray(size_t length) = 0;
+    virtual NativeValue* CreateArrayWithElements(NativeValue* const* values, size_t count) = 0;
+    virtual NativeValue* CreateArrayFromNumbers(NativeTypedArrayType type, const void* data, size_t length) = 0;
 
     virtual NativeValue* CreateArrayBuffer(void** value, size_t length) = 0;
     virtual NativeValue* CreateArrayBufferExternal(void* value, size_t length, NativeFinalize cb, void* hint) = 0;
@@ -120,6 +128,8 @@ public:
                                              void* data);
 
     virtual NativeReference* CreateReference(NativeValue* value, uint32_t initialRefcount) = 0;
+    virtual NativePreparedCall* PrepareCall(NativeValue* thisVar, NativeValue* function, size_t argc) = 0;
+    virtual NativeObjectTemplate* CreateObjectTemplate(const char* const* names, size_t count) = 0;
 
     virtual bool Throw(NativeValue* error) = 0;
     virtual bool Throw(NativeErrorType type, const char* code, const char* message) = 0;
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_ACE_NAPI_NATIVE_ENGINE_NATIVE_OBJECT_TEMPLATE_H
+#define FOUNDATION_ACE_NAPI_NATIVE_ENGINE_NATIVE_OBJECT_TEMPLATE_H
+
+#include "native_engine/native_value.h"
+
+class NativeEngine;
+
+// Field list of same-shaped objects, with the names interned once. Fields are defined in order
+// as writable, enumerable and configurable data properties, as an object literal does.
+class NativeObjectTemplate {
+public:
+    virtual ~NativeObjectTemplate() {}
+    // Field names belong to the engine that created the template.
+    virtual NativeEngine* GetEngine() = 0;
+    virtual size_t GetFieldCount() = 0;
+    // values has one entry per field. A null entry defines the field as undefined.
+    virtual NativeValue* CreateInstance(NativeValue* const* values) = 0;
+    // Defines the fields on an existing object. Fails when the object rejects one of them.
+    virtual bool DefineFields(NativeValue* object, NativeValue* const* values) = 0;
+};
+
+#endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_NATIVE_OBJECT_TEMPLATE_H */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_ACE_NAPI_NATIVE_ENGINE_NATIVE_PREPARED_CALL_H
+#define FOUNDATION_ACE_NAPI_NATIVE_ENGINE_NATIVE_PREPARED_CALL_H
+
+#include "native_engine/native_value.h"
+
+class NativeEngine;
+
+// Function and receiver bound once for repeated calls. Arguments are kept in a frame owned by
+// the call and reused by every Call, so small calls do not allocate.
+class NativePreparedCall {
+public:
+    virtual ~NativePreparedCall() {}
+    virtual NativeEngine* GetEngine() = 0;
+    virtual size_t GetArgc() = 0;
+    // Replaces one argument of the frame. Fails when index is out of range or while the
+    // call is running.
+    virtual bool SetArgument(size_t index, NativeValue* value) = 0;
+    // Returns nullptr when the function throws, as NativeEngine::CallFunction does.
+    virtual NativeValue* Call() = 0;
+    // Deletes the call. A call released by its own callee is deleted once the outermost
+    // Call returns.
+    virtual void Release() = 0;
+};
+
+#endif /* FOUNDATION_ACE_NAPI_NATIVE_ENGINE_NATIVE_PREPARED_CALL_H */
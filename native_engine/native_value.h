@@ -44,16 +44,98 @@ struct NativeFunctionInfo {
     void* data = nullptr;
 };
 
+// Engine independent description of a native function, instantiated by
+// NativeEngine::CreateFunction. Instances copy it, so a template may be released while
+// functions made from it are alive.
+struct NativeFunctionTemplate {
+    NativeCallback callback = nullptr;
+    void* data = nullptr;
+};
+
+// Property name interned once by NativeEngine::CreatePropertyKey. The key is owned by the
+// engine and stays valid for the engine's lifetime.
+struct NativePropertyKey {
+    NativeEngine* engine = nullptr;
+    uint32_t id = 0;
+};
+
+// Cache for reading one property from many objects, owned by the call site. Reads that take
+// the full property lookup count as misses, which is every read on engines without an inline
+// cache.
+struct NativePropertyCache {
+    const NativePropertyKey* key = nullptr;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+// 128-bit tag marking which native type an object wraps, laid out as napi_type_tag.
+struct NativeTypeTag {
+    uint64_t lower;
+    uint64_t upper;
+};
+
+// Wraps argument index of a callback, or its receiver for NATIVE_CALLBACK_THIS_INDEX and its
+// new.target for NATIVE_CALLBACK_NEW_TARGET_INDEX, into a value of the current scope.
+typedef NativeValue* (*NativeCallbackArgumentLoader)(NativeCallbackInfo* info, size_t index);
+
+constexpr size_t NATIVE_CALLBACK_THIS_INDEX = SIZE_MAX;
+constexpr size_t NATIVE_CALLBACK_NEW_TARGET_INDEX = SIZE_MAX - 1;
+
 struct NativeCallbackInfo {
     size_t argc = 0;
     NativeValue** argv = nullptr;
     NativeValue* thisVar = nullptr;
     NativeValue* function = nullptr;
     NativeFunctionInfo* functionInfo = nullptr;
+    // Engines that wrap arguments on demand leave argv, thisVar and function null and set
+    // loader. rawArgv, rawThis and rawNewTarget then point at the engine values for the
+    // duration of the call; rawNewTarget stays null outside of constructor calls.
+    NativeCallbackArgumentLoader loader = nullptr;
+    const void* rawArgv = nullptr;
+    const void* rawThis = nullptr;
+    const void* rawNewTarget = nullptr;
+
+    NativeValue* GetArgument(size_t index)
+    {
+        return (loader != nullptr) ? loader(this, index) : argv[index];
+    }
+
+    NativeValue* GetThis()
+    {
+        return (thisVar == nullptr && loader != nullptr) ? loader(this, NATIVE_CALLBACK_THIS_INDEX) : thisVar;
+    }
+
+    NativeValue* GetFunction()
+    {
+        return (function == nullptr && rawNewTarget != nullptr) ? loader(this, NATIVE_CALLBACK_NEW_TARGET_INDEX)
+                                                                : function;
+    }
 };
 
 typedef void (*NaitveFinalize)(NativeEngine* env, void* data, void* hint);
 
+// Called for each property by NativeObject::ForEachProperty. Returning false stops the iteration.
+typedef bool (*NativePropertyCallback)(NativeValue* key, NativeValue* value, void* data);
+
+enum NativeKeyCollectionMode {
+    NATIVE_KEY_INCLUDE_PROTOTYPES,
+    NATIVE_KEY_OWN_ONLY,
+};
+
+enum NativeKeyFilter {
+    NATIVE_KEY_ALL_PROPERTIES = 0,
+    NATIVE_KEY_WRITABLE = 1,
+    NATIVE_KEY_ENUMERABLE = 1 << 1,
+    NATIVE_KEY_CONFIGURABLE = 1 << 2,
+    NATIVE_KEY_SKIP_STRINGS = 1 << 3,
+    NATIVE_KEY_SKIP_SYMBOLS = 1 << 4,
+};
+
+enum NativeKeyConversion {
+    NATIVE_KEY_KEEP_NUMBERS,
+    NATIVE_KEY_NUMBERS_TO_STRINGS,
+};
+
 enum NativeValueType {
     NATIVE_UNDEFINED,
     NATIVE_NULL,
@@ -101,6 +183,10 @@ public:
     virtual NativeValue* ToString() = 0;
     virtual NativeValue* ToObject() = 0;
 
+    // Wraps the same engine value again, in the current scope like any new value. Values
+    // the engine shares between scopes return themselves.
+    virtual NativeValue* Duplicate() = 0;
+
     virtual bool operator==(NativeValue* value) = 0;
 
 protected:
@@ -145,6 +231,10 @@ public:
     static const int INTERFACE_ID = 2;
 
     virtual void GetCString(char* buffer, size_t size, size_t* length) = 0;
+    // Returns the UTF-8 contents without copying them; valid as long as this value.
+    virtual const char* GetCStringView(size_t* length) = 0;
+    virtual void GetCStringLatin1(char* buffer, size_t size, size_t* length) = 0;
+    virtual void GetCStringUtf16(char16_t* buffer, size_t size, size_t* length) = 0;
     virtual size_t GetLength() = 0;
     virtual size_t EncodeWriteUtf8(char* buffer, size_t bufferSize, int32_t* nchars) = 0;
 };
@@ -153,10 +243,22 @@ class NativeObject {
 public:
     static const int INTERFACE_ID = 3;
 
-    virtual void SetNativePointer(void* pointer, NativeFinalize cb, void* hint) = 0;
+    // Fails when the object already wraps a pointer or can not hold one.
+    virtual bool SetNativePointer(void* pointer, NativeFinalize cb, void* hint) = 0;
     virtual void* GetNativePointer() = 0;
+    // Type tags are set once per object and live next to its wrapped pointer.
+    virtual bool SetTypeTag(const NativeTypeTag* tag) = 0;
+    virtual bool CheckTypeTag(const NativeTypeTag* tag) = 0;
+    // Returns the wrapped pointer only when the object carries tag.
+    virtual void* GetNativePointer(const NativeTypeTag* tag) = 0;
 
     virtual NativeValue* GetPropertyNames() = 0;
+    virtual NativeValue* GetAllPropertyNames(NativeKeyCollectionMode mode,
+                                             int filter,
+                                             NativeKeyConversion conversion) = 0;
+    // Visits own enumerable string keyed properties, each in its own handle scope. Returns false
+    // only when listing or reading the properties throws; callback stopping early is not a failure.
+    virtual bool ForEachProperty(NativePropertyCallback callback, void* data) = 0;
 
     virtual NativeValue* GetPrototype() = 0;
 
@@ -172,12 +274,44 @@ public:
     virtual bool HasProperty(const char* name) = 0;
     virtual bool DeleteProperty(const char* name) = 0;
 
+    virtual bool SetProperty(const NativePropertyKey* key, NativeValue* value) = 0;
+    virtual NativeValue* GetProperty(const NativePropertyKey* key) = 0;
+    virtual bool HasProperty(const NativePropertyKey* key) = 0;
+    virtual bool DeleteProperty(const NativePropertyKey* key) = 0;
+    virtual NativeValue* GetProperty(NativePropertyCache* cache) = 0;
+
+    // Batched access by interned keys. values, found and results have one entry per key, found
+    // and results may be null. Both stop at the first exception and return false, leaving the
+    // entries from the failing key on unset.
+    virtual bool GetProperties(const NativePropertyKey* const* keys,
+                               size_t count,
+                               NativeValue** values,
+                               bool* found) = 0;
+    virtual bool SetProperties(const NativePropertyKey* const* keys,
+                               NativeValue* const* values,
+                               size_t count,
+                               bool* results) = 0;
+
     virtual bool SetPrivateProperty(const char* name, NativeValue* value) = 0;
     virtual NativeValue* GetPrivateProperty(const char* name) = 0;
     virtual bool HasPrivateProperty(const char* name) = 0;
     virtual bool DeletePrivateProperty(const char* name) = 0;
 };
 
+enum NativeTypedArrayType {
+    NATIVE_INT8_ARRAY,
+    NATIVE_UINT8_ARRAY,
+    NATIVE_UINT8_CLAMPED_ARRAY,
+    NATIVE_INT16_ARRAY,
+    NATIVE_UINT16_ARRAY,
+    NATIVE_INT32_ARRAY,
+    NATIVE_UINT32_ARRAY,
+    NATIVE_FLOAT32_ARRAY,
+    NATIVE_FLOAT64_ARRAY,
+    NATIVE_BIGINT64_ARRAY,
+    NATIVE_BIGUINT64_ARRAY,
+};
+
 class NativeArray {
 public:
     static const int INTERFACE_ID = 4;
@@ -187,6 +321,24 @@ public:
     virtual bool HasElement(uint32_t index) = 0;
     virtual bool DeleteElement(uint32_t index) = 0;
 
+    // Copy count elements starting at start between the array and a native array of values.
+    // Both stop at the first exception and return false. stored is cleared when the engine
+    // rejects an element without throwing. Engines may still access each element on its own;
+    // one call only saves the per-element call overhead.
+    virtual bool SetElements(uint32_t start, NativeValue* const* values, size_t count, bool* stored) = 0;
+    virtual bool GetElements(uint32_t start, size_t count, NativeValue** values) = 0;
+
+    // Converts the first length elements to int32, float32 or float64 numbers, as given by type.
+    // Elements that are not numbers are stored as 0 or NaN and counted in invalidCount, and the
+    // first invalidCapacity of their indices are written to invalidIndices. Returns false when
+    // reading an element throws.
+    virtual bool GetNumbers(NativeTypedArrayType type,
+                            void* data,
+                            size_t length,
+                            uint32_t* invalidIndices,
+                            size_t invalidCapacity,
+                            size_t* invalidCount) = 0;
+
     virtual uint32_t GetLength() = 0;
 };
 
@@ -198,20 +350,6 @@ public:
     virtual size_t GetLength() = 0;
 };
 
-enum NativeTypedArrayType {
-    NATIVE_INT8_ARRAY,
-    NATIVE_UINT8_ARRAY,
-    NATIVE_UINT8_CLAMPED_ARRAY,
-    NATIVE_INT16_ARRAY,
-    NATIVE_UINT16_ARRAY,
-    NATIVE_INT32_ARRAY,
-    NATIVE_UINT32_ARRAY,
-    NATIVE_FLOAT32_ARRAY,
-    NATIVE_FLOAT64_ARRAY,
-    NATIVE_BIGINT64_ARRAY,
-    NATIVE_BIGUINT64_ARRAY,
-};
-
 class NativeTypedArray {
 public:
     static const int INTERFACE_ID = 6;
@@ -221,6 +359,14 @@ public:
     virtual NativeValue* GetArrayBuffer() = 0;
     virtual void* GetData() = 0;
     virtual size_t GetOffset() = 0;
+
+    // Same as NativeArray::GetNumbers, converting from the element type of the typed array.
+    virtual bool GetNumbers(NativeTypedArrayType type,
+                            void* data,
+                            size_t length,
+                            uint32_t* invalidIndices,
+                            size_t invalidCapacity,
+                            size_t* invalidCount) = 0;
 };
 
 class NativeDataView {
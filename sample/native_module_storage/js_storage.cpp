@@ -34,6 +34,8 @@ static std::map<std::string, std::string> g_keyValueStorage;
  ***********************************************/
 struct EventHandler {
     napi_ref callbackRef = nullptr;
+    // Listeners are called with no arguments and an undefined this, prepared once when added.
+    napi_prepared_call call = nullptr;
     EventHandler* next = nullptr;
 };
 
@@ -55,6 +57,7 @@ public:
             handlers_ = temp;
         }
         napi_create_reference(env, handler, 1, &handlers_->callbackRef);
+        napi_prepare_call(env, nullptr, handler, 0, &handlers_->call);
     }
 
     void Del(napi_env env, napi_value handler)
@@ -72,6 +75,7 @@ public:
                     temp->next = i->next;
                 }
                 napi_delete_reference(env, i->callbackRef);
+                napi_delete_prepared_call(env, i->call);
                 delete i;
             } else {
                 temp = i;
@@ -83,6 +87,7 @@ public:
     {
         for (EventHandler* i = handlers_; i != nullptr; i = handlers_) {
             handlers_ = i->next;
+            napi_delete_prepared_call(env, i->call);
             delete i;
         }
     }
@@ -158,7 +163,14 @@ public:
         if (event == STORAGE_EVENT_UNKNOWN) {
             return;
         }
-        for (EventHandler* handler = listeners_[event].handlers_; handler != nullptr; handler = handler->next) {
+        EventHandler* next = nullptr;
+        for (EventHandler* handler = listeners_[event].handlers_; handler != nullptr; handler = next) {
+            // A listener may remove itself with off() while it runs.
+            next = handler->next;
+            if (thisArg == nullptr && handler->call != nullptr) {
+                napi_invoke_prepared_call(env_, handler->call, nullptr);
+                continue;
+            }
             if (thisArg == nullptr) {
                 napi_get_undefined(env_, &thisArg);
             }
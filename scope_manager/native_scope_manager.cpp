@@ -18,24 +18,53 @@
 #include "native_engine/native_value.h"
 #include "utils/log.h"
 
+namespace {
+constexpr size_t NATIVE_HANDLE_BLOCK_SIZE = 256;
+} // namespace
+
+// A handle either refers to a value allocated elsewhere, or owns a value constructed
+// in its inline storage, in which case value points at storage.
 struct NativeHandle {
-    NativeValue* value = nullptr;
-    NativeHandle* sibling = nullptr;
+    NativeValue* value;
+    alignas(void*) char storage[NATIVE_VALUE_INLINE_SIZE];
+
+    bool IsInline() const
+    {
+        return value == reinterpret_cast<const NativeValue*>(storage);
+    }
+};
+
+// Handles live in a stack of fixed-size blocks. A scope only remembers where the
+// stack top was when it was opened, so closing it is a single walk back to that mark.
+struct NativeHandleBlock {
+    NativeHandle handles[NATIVE_HANDLE_BLOCK_SIZE];
+    NativeHandleBlock* prev = nullptr;
+    NativeHandleBlock* next = nullptr;
 };
 
 struct NativeScope {
-    NativeHandle* handlePtr = nullptr;
+    NativeHandleBlock* handleBlock = nullptr;
+    NativeHandle* handleMark = nullptr;
+    NativeHandle* escapeSlot = nullptr;
     size_t handleCount = 0;
     bool escaped = false;
+    bool escapeCalled = false;
 
     NativeScope* child = nullptr;
     NativeScope* parent = nullptr;
 };
 
 NativeScopeManager::NativeScopeManager()
+    : root_(nullptr), current_(nullptr), freeScope_(nullptr),
+      handleBlock_(nullptr), handleNext_(nullptr), handleLimit_(nullptr), reservedHandle_(nullptr)
 {
+    handleBlock_ = new NativeHandleBlock;
     root_ = new NativeScope();
-    if (root_) {
+    if (root_ && handleBlock_) {
+        handleNext_ = handleBlock_->handles;
+        handleLimit_ = handleBlock_->handles + NATIVE_HANDLE_BLOCK_SIZE;
+        root_->handleBlock = handleBlock_;
+        root_->handleMark = handleNext_;
         current_ = root_;
     } else {
         HILOG_ERROR("Construct NativeScopeManager error.");
@@ -44,26 +73,42 @@ NativeScopeManager::NativeScopeManager()
 
 NativeScopeManager::~NativeScopeManager()
 {
-    NativeScope* scope = root_;
-    while (scope != nullptr) {
-        NativeScope* tempScope = scope->child;
-        NativeHandle* handle = scope->handlePtr;
-        while (handle != nullptr) {
-            NativeHandle* tempHandle = handle->sibling;
-            delete handle->value;
-            delete handle;
-            handle = tempHandle;
-        }
+    while (current_ != nullptr && current_ != root_) {
+        PopScope();
+    }
+    if (root_ != nullptr) {
+        ReleaseHandles(root_->handleBlock, root_->handleMark);
+        delete root_;
+    }
+    while (freeScope_ != nullptr) {
+        NativeScope* scope = freeScope_;
+        freeScope_ = scope->child;
         delete scope;
-        scope = tempScope;
+    }
+    NativeHandleBlock* block = handleBlock_;
+    while (block != nullptr) {
+        NativeHandleBlock* next = block->next;
+        delete block;
+        block = next;
     }
     root_ = nullptr;
     current_ = nullptr;
+    handleBlock_ = nullptr;
+    handleNext_ = nullptr;
+    handleLimit_ = nullptr;
 }
 
 NativeScope* NativeScopeManager::Open()
 {
-    auto scope = new NativeScope();
+    NativeScope* scope = freeScope_;
+    if (scope != nullptr) {
+        freeScope_ = scope->child;
+        *scope = NativeScope();
+    } else {
+        scope = new NativeScope();
+    }
+    scope->handleBlock = handleBlock_;
+    scope->handleMark = handleNext_;
     current_->child = scope;
     scope->parent = current_;
     current_ = scope;
@@ -76,27 +121,36 @@ void NativeScopeManager::Close(NativeScope* scope)
     if ((scope == nullptr) || (scope == root_)) {
         return;
     }
-    if (scope == current_) {
-        current_ = scope->parent;
-    }
 
-    scope->parent->child = scope->child;
+    NativeScope* temp = current_;
+    while (temp != nullptr && temp != scope) {
+        temp = temp->parent;
+    }
+    if (temp == nullptr) {
+        HILOG_ERROR("Close a scope which is not opened.");
+        return;
+    }
 
-    NativeHandle* handle = scope->handlePtr;
-    while (handle != nullptr) {
-        scope->handlePtr = handle->sibling;
-        delete handle->value;
-        delete handle;
-        handle = scope->handlePtr;
+    // Scopes opened inside this one can not outlive it.
+    while (current_ != scope) {
+        PopScope();
     }
-    delete scope;
+    PopScope();
 }
 
 NativeScope* NativeScopeManager::OpenEscape()
 {
+    // Reserve the slot in the outer scope that the escaped value will occupy.
+    NativeHandle* escapeSlot = AllocHandle();
+    if (escapeSlot == nullptr) {
+        return nullptr;
+    }
+    escapeSlot->value = nullptr;
+
     NativeScope* scope = Open();
     if (scope != nullptr) {
         scope->escaped = true;
+        scope->escapeSlot = escapeSlot;
     }
     return scope;
 }
@@ -111,50 +165,133 @@ void NativeScopeManager::CloseEscape(NativeScope* scope)
 
 NativeValue* NativeScopeManager::Escape(NativeScope* scope, NativeValue* value)
 {
-    NativeValue* result = nullptr;
+    if ((scope == nullptr) || (value == nullptr) || !scope->escaped || scope->escapeCalled) {
+        return nullptr;
+    }
+    scope->escapeCalled = true;
 
-    if ((scope == nullptr) || (value == nullptr)) {
-        return result;
+    // The value is wrapped again in the slot reserved in the outer scope, without looking up
+    // which scope owns it, and the original is released with this scope. Values the engine
+    // shares between scopes, such as singletons, come back as they are and leave the slot
+    // empty. A value owned by an outer scope gets a second wrapper that lives as long as
+    // the slot.
+    reservedHandle_ = scope->escapeSlot;
+    NativeValue* result = value->Duplicate();
+    reservedHandle_ = nullptr;
+    return result;
+}
+
+bool NativeScopeManager::IsEscapeCalled(NativeScope* scope)
+{
+    return (scope != nullptr) && scope->escapeCalled;
+}
+
+void NativeScopeManager::CreateHandle(NativeValue* value)
+{
+    NativeHandle* handle = AllocHandle();
+    if (handle == nullptr) {
+        return;
     }
+    handle->value = value;
+}
 
-    NativeHandle* handle = scope->handlePtr;
-    NativeHandle* temp = nullptr;
-    while (handle != nullptr && scope->escaped) {
-        if (handle->value == value) {
-            if (temp == nullptr) {
-                scope->handlePtr = handle->sibling;
-            } else {
-                temp->sibling = handle->sibling;
-            }
-            if (scope->parent->handlePtr == nullptr) {
-                scope->parent->handlePtr = handle;
-                handle->sibling = nullptr;
-            } else {
-                handle->sibling = scope->parent->handlePtr;
-                scope->parent->handlePtr = handle;
+void* NativeScopeManager::AllocValue(size_t size)
+{
+    if (size > NATIVE_VALUE_INLINE_SIZE) {
+        return nullptr;
+    }
+    NativeHandle* handle = AllocHandle();
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    handle->value = reinterpret_cast<NativeValue*>(handle->storage);
+    return handle->storage;
+}
+
+NativeHandle* NativeScopeManager::AllocHandle()
+{
+    if (reservedHandle_ != nullptr) {
+        // Escape wraps the escaped value in the slot reserved in the outer scope.
+        NativeHandle* handle = reservedHandle_;
+        reservedHandle_ = nullptr;
+        return handle;
+    }
+    if (handleNext_ == handleLimit_) {
+        NativeHandleBlock* block = handleBlock_->next;
+        if (block == nullptr) {
+            block = new NativeHandleBlock;
+            if (block == nullptr) {
+                HILOG_ERROR("Alloc native handle block error.");
+                return nullptr;
             }
-            scope->handleCount--;
-            scope->parent->handleCount++;
-            result = scope->parent->handlePtr->value;
-            break;
+            block->prev = handleBlock_;
+            handleBlock_->next = block;
         }
-        temp = handle;
-        handle = handle->sibling;
+        handleBlock_ = block;
+        handleNext_ = block->handles;
+        handleLimit_ = block->handles + NATIVE_HANDLE_BLOCK_SIZE;
     }
-    return result;
+    current_->handleCount++;
+    return handleNext_++;
 }
 
-void NativeScopeManager::CreateHandle(NativeValue* value)
+void NativeScopeManager::ReleaseHandles(NativeHandleBlock* block, NativeHandle* mark)
 {
-    if (current_->handlePtr == nullptr) {
-        current_->handlePtr = new NativeHandle();
-        current_->handlePtr->value = value;
-        current_->handlePtr->sibling = nullptr;
-    } else {
-        auto temp = new NativeHandle();
-        temp->sibling = current_->handlePtr;
-        temp->value = value;
-        current_->handlePtr = temp;
+    while (handleBlock_ != block) {
+        for (NativeHandle* handle = handleBlock_->handles; handle < handleNext_; handle++) {
+            ReleaseHandle(handle);
+        }
+        handleBlock_ = handleBlock_->prev;
+        handleNext_ = handleBlock_->handles + NATIVE_HANDLE_BLOCK_SIZE;
     }
-    current_->handleCount++;
+    for (NativeHandle* handle = mark; handle < handleNext_; handle++) {
+        ReleaseHandle(handle);
+    }
+    handleNext_ = mark;
+    handleLimit_ = block->handles + NATIVE_HANDLE_BLOCK_SIZE;
+
+    // Keep one spare block so that a scope oscillating around a block boundary
+    // does not allocate on every open, and give the rest back.
+    NativeHandleBlock* spare = block->next;
+    if (spare != nullptr) {
+        NativeHandleBlock* extra = spare->next;
+        spare->next = nullptr;
+        while (extra != nullptr) {
+            NativeHandleBlock* next = extra->next;
+            delete extra;
+            extra = next;
+        }
+    }
+}
+
+void NativeScopeManager::ReleaseHandle(NativeHandle* handle)
+{
+    NativeValue* value = handle->value;
+    if (value == nullptr) {
+        return;
+    }
+    if (handle->IsInline()) {
+        value->~NativeValue();
+        return;
+    }
+    delete value;
+}
+
+void NativeScopeManager::PopScope()
+{
+    NativeScope* scope = current_;
+    ReleaseHandles(scope->handleBlock, scope->handleMark);
+
+    current_ = scope->parent;
+    // OpenEscape reserved the slot right below this scope's mark, so a slot nothing escaped
+    // into is on top of the stack again and is popped as well.
+    if ((scope->escapeSlot != nullptr) && (scope->escapeSlot->value == nullptr)) {
+        handleNext_ = scope->escapeSlot;
+        current_->handleCount--;
+    }
+    current_->child = nullptr;
+
+    scope->child = freeScope_;
+    scope->parent = nullptr;
+    freeScope_ = scope;
 }
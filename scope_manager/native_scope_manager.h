@@ -19,8 +19,14 @@
 #include <stddef.h>
 
 class NativeValue;
+struct NativeHandle;
+struct NativeHandleBlock;
 struct NativeScope;
 
+// Largest value wrapper that can be stored inline in a handle, chosen so a handle takes
+// 64 bytes on 64 bit targets.
+constexpr size_t NATIVE_VALUE_INLINE_SIZE = 56;
+
 class NativeScopeManager {
 public:
     NativeScopeManager();
@@ -34,10 +40,29 @@ public:
 
     virtual void CreateHandle(NativeValue* value);
     virtual NativeValue* Escape(NativeScope* scope, NativeValue* value);
+    virtual bool IsEscapeCalled(NativeScope* scope);
+
+    // Returns storage for a value owned by the current scope, or nullptr if size exceeds
+    // NATIVE_VALUE_INLINE_SIZE. The value must be constructed in place right away, and is
+    // destroyed in place when its owning scope closes. Escaping it wraps it again in the
+    // outer scope rather than moving it.
+    void* AllocValue(size_t size);
 
 private:
+    NativeHandle* AllocHandle();
+    void ReleaseHandles(NativeHandleBlock* block, NativeHandle* mark);
+    void ReleaseHandle(NativeHandle* handle);
+    void PopScope();
+
     NativeScope* root_;
     NativeScope* current_;
+    NativeScope* freeScope_;
+
+    NativeHandleBlock* handleBlock_;
+    NativeHandle* handleNext_;
+    NativeHandle* handleLimit_;
+    // Handle the next value is constructed in instead of the top of the stack, set by Escape.
+    NativeHandle* reservedHandle_;
 };
 
 #endif /* FOUNDATION_ACE_NAPI_SCOPE_MANAGER_NATIVE_SCOPE_MANAGER_H */
@@ -0,0 +1,1107 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "napi/native_api.h"
+#include "napi/native_node_api.h"
+#include "quickjs_native_engine.h"
+#include "scope_manager/native_scope_manager.h"
+
+#define ASSERT_CHECK_CALL(call)   \
+    {                             \
+        ASSERT_EQ(call, napi_ok); \
+    }
+
+namespace {
+using BenchmarkClock = std::chrono::steady_clock;
+
+constexpr int BENCHMARK_SCOPE_COUNT = 10000;
+constexpr int BENCHMARK_HANDLES_PER_SCOPE = 100;
+constexpr int BENCHMARK_LISTENER_COUNT = 32;
+constexpr size_t BENCHMARK_STRING_SIZE = 64 * 1024;
+constexpr int BENCHMARK_ENCODE_COUNT = 1000;
+constexpr size_t BENCHMARK_OPTION_COUNT = 10;
+constexpr int BENCHMARK_CALL_COUNT = 1000000;
+
+double ElapsedSeconds(BenchmarkClock::time_point start)
+{
+    return std::chrono::duration<double>(BenchmarkClock::now() - start).count();
+}
+
+void ReportRate(const char* name, double count, double seconds)
+{
+    double rate = (seconds > 0) ? (count / seconds) : 0;
+    printf("[ BENCHMARK ] %s: %.0f ops/s (%.0f ops in %.3f s)\n", name, rate, count, seconds);
+}
+
+void BenchmarkJSValueToNativeValue(NativeEngine* engine, const char* name, napi_value value)
+{
+    auto quickJSEngine = static_cast<QuickJSNativeEngine*>(engine);
+    JSContext* context = quickJSEngine->GetContext();
+    JSValue jsValue = *reinterpret_cast<NativeValue*>(value);
+    NativeScopeManager* scopeManager = engine->GetScopeManager();
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        NativeScope* scope = scopeManager->Open();
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            QuickJSNativeEngine::JSValueToNativeValue(quickJSEngine, JS_DupValue(context, jsValue));
+        }
+        scopeManager->Close(scope);
+    }
+    ReportRate(name, (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE, ElapsedSeconds(start));
+}
+} // namespace
+
+/**
+ * @tc.name: HandleScopeBenchmark
+ * @tc.desc: Measure handles created and released per second through handle scopes.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, HandleScopeBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value value = nullptr;
+            ASSERT_CHECK_CALL(napi_create_int32(env, j, &value));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+    }
+    ReportRate("handles", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE, ElapsedSeconds(start));
+}
+
+/**
+ * @tc.name: NestedEscapeScopeBenchmark
+ * @tc.desc: Measure open/escape/close cycles of nested escapable handle scopes.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, NestedEscapeScopeBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope outer = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &outer));
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_escapable_handle_scope scope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_escapable_handle_scope(env, &scope));
+        napi_value value = nullptr;
+        ASSERT_CHECK_CALL(napi_create_int32(env, i, &value));
+        napi_value escaped = nullptr;
+        ASSERT_CHECK_CALL(napi_escape_handle(env, scope, value, &escaped));
+        ASSERT_CHECK_CALL(napi_close_escapable_handle_scope(env, scope));
+    }
+    ReportRate("escapable scopes", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, outer));
+}
+
+/**
+ * @tc.name: JSValueToNativeValueBenchmark
+ * @tc.desc: Measure JSValue to NativeValue conversions per second for each kind of value.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, JSValueToNativeValueBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value number = nullptr;
+    ASSERT_CHECK_CALL(napi_create_double(env, 1.5, &number));
+    napi_value string = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "benchmark", NAPI_AUTO_LENGTH, &string));
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    napi_value array = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array(env, &array));
+    napi_value function = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function(env, "benchmark", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value { return nullptr; }, nullptr, &function));
+    void* data = nullptr;
+    napi_value arrayBuffer = nullptr;
+    ASSERT_CHECK_CALL(napi_create_arraybuffer(env, 16, &data, &arrayBuffer));
+    napi_value typedArray = nullptr;
+    ASSERT_CHECK_CALL(napi_create_typedarray(env, napi_float64_array, 2, arrayBuffer, 0, &typedArray));
+    napi_value dataView = nullptr;
+    ASSERT_CHECK_CALL(napi_create_dataview(env, 16, arrayBuffer, 0, &dataView));
+    napi_deferred deferred = nullptr;
+    napi_value promise = nullptr;
+    ASSERT_CHECK_CALL(napi_create_promise(env, &deferred, &promise));
+    napi_value external = nullptr;
+    ASSERT_CHECK_CALL(napi_create_external(env, (void*)1, [](napi_env env, void* data, void* hint) {}, nullptr,
+        &external));
+
+    BenchmarkJSValueToNativeValue(engine_, "number", number);
+    BenchmarkJSValueToNativeValue(engine_, "string", string);
+    BenchmarkJSValueToNativeValue(engine_, "object", object);
+    BenchmarkJSValueToNativeValue(engine_, "array", array);
+    BenchmarkJSValueToNativeValue(engine_, "function", function);
+    BenchmarkJSValueToNativeValue(engine_, "arraybuffer", arrayBuffer);
+    BenchmarkJSValueToNativeValue(engine_, "typedarray", typedArray);
+    BenchmarkJSValueToNativeValue(engine_, "dataview", dataView);
+    BenchmarkJSValueToNativeValue(engine_, "promise", promise);
+    BenchmarkJSValueToNativeValue(engine_, "external", external);
+
+    napi_value undefined = nullptr;
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &undefined));
+    ASSERT_CHECK_CALL(napi_resolve_deferred(env, deferred, undefined));
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: ExternalCreationBenchmark
+ * @tc.desc: Measure napi_create_external, napi_get_value_external and native function creation.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ExternalCreationBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+    static int nativeObject = 0;
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        napi_open_handle_scope(env, &scope);
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value external = nullptr;
+            napi_create_external(env, &nativeObject, [](napi_env env, void* data, void* hint) {}, nullptr,
+                                 &external);
+        }
+        napi_close_handle_scope(env, scope);
+    }
+    ReportRate("externals created", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+    napi_value external = nullptr;
+    ASSERT_CHECK_CALL(napi_create_external(env, &nativeObject, [](napi_env env, void* data, void* hint) {},
+                                           nullptr, &external));
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_CALL_COUNT; i++) {
+        void* data = nullptr;
+        napi_get_value_external(env, external, &data);
+        ASSERT_EQ(data, &nativeObject);
+    }
+    ReportRate("externals read", BENCHMARK_CALL_COUNT, ElapsedSeconds(start));
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        napi_open_handle_scope(env, &innerScope);
+        napi_value function = nullptr;
+        napi_create_function(env, "f", NAPI_AUTO_LENGTH,
+                             [](napi_env env, napi_callback_info info) -> napi_value { return nullptr; }, nullptr,
+                             &function);
+        napi_close_handle_scope(env, innerScope);
+    }
+    ReportRate("functions created", BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+}
+
+/**
+ * @tc.name: ListenerLookupBenchmark
+ * @tc.desc: Measure the listener lookup pattern of the samples, a napi_strict_equals scan over a listener list.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ListenerLookupBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value listeners[BENCHMARK_LISTENER_COUNT] = { nullptr };
+    for (int i = 0; i < BENCHMARK_LISTENER_COUNT; i++) {
+        ASSERT_CHECK_CALL(napi_create_function(env, "listener", NAPI_AUTO_LENGTH,
+            [](napi_env env, napi_callback_info info) -> napi_value { return nullptr; }, nullptr, &listeners[i]));
+    }
+
+    int compares = 0;
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_value target = listeners[i % BENCHMARK_LISTENER_COUNT];
+        for (int j = 0; j < BENCHMARK_LISTENER_COUNT; j++) {
+            bool isEquals = false;
+            ASSERT_CHECK_CALL(napi_strict_equals(env, listeners[j], target, &isEquals));
+            compares++;
+            if (isEquals) {
+                break;
+            }
+        }
+    }
+    ReportRate("listener compares", (double)compares, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: EncodeToUtf8Benchmark
+ * @tc.desc: Measure bytes per second written by EncodeToUtf8 for a 64 KB ASCII string and a non ASCII one.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, EncodeToUtf8Benchmark, testing::ext::TestSize.Level1)
+{
+    NativeScopeManager* scopeManager = engine_->GetScopeManager();
+    NativeScope* scope = scopeManager->Open();
+
+    std::string ascii(BENCHMARK_STRING_SIZE, 'a');
+    std::string latin1;
+    while (latin1.size() < BENCHMARK_STRING_SIZE) {
+        latin1 += "caf\xc3\xa9 ";
+    }
+    std::vector<char> buffer(BENCHMARK_STRING_SIZE * 2);
+
+    for (const std::string* str : { &ascii, &latin1 }) {
+        NativeValue* value = engine_->CreateString(str->c_str(), str->length());
+        int32_t written = 0;
+        int32_t nchars = 0;
+        auto start = BenchmarkClock::now();
+        for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+            engine_->EncodeToUtf8(value, buffer.data(), &written, buffer.size(), &nchars);
+        }
+        double seconds = ElapsedSeconds(start);
+        ASSERT_EQ((size_t)written, str->length());
+        ReportRate((str == &ascii) ? "ascii utf8 bytes" : "latin1 utf8 bytes",
+                   (double)written * BENCHMARK_ENCODE_COUNT, seconds);
+    }
+
+    scopeManager->Close(scope);
+}
+
+/**
+ * @tc.name: GetValueStringUtf8Benchmark
+ * @tc.desc: Measure the size then copy pattern of napi_get_value_string_utf8 on a 64 KB string.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, GetValueStringUtf8Benchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    std::string str(BENCHMARK_STRING_SIZE, 'a');
+    napi_value value = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, str.c_str(), str.length(), &value));
+    std::vector<char> buffer(BENCHMARK_STRING_SIZE + 1);
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+        size_t length = 0;
+        ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, value, nullptr, 0, &length));
+        ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, value, buffer.data(), length + 1, &length));
+    }
+    ReportRate("string size and copy pairs", (double)BENCHMARK_ENCODE_COUNT, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: StringEncodingBenchmark
+ * @tc.desc: Measure creating and reading back 64 KB strings through the latin1, utf8 and utf16 paths,
+ *           and creating short latin1 strings.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, StringEncodingBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    std::string latin1;
+    while (latin1.size() < BENCHMARK_STRING_SIZE) {
+        latin1 += "caf\xe9 ";
+    }
+    std::string utf8;
+    std::u16string utf16;
+    while (utf16.size() < BENCHMARK_STRING_SIZE) {
+        utf8 += "\xe4\xb8\xad\xe6\x96\x87 text ";
+        utf16 += u"中文 text ";
+    }
+    std::vector<char> buffer(utf8.size() + 1);
+    std::vector<char16_t> buffer16(utf16.size() + 1);
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+        napi_value value = nullptr;
+        size_t length = 0;
+        ASSERT_CHECK_CALL(napi_create_string_latin1(env, latin1.c_str(), latin1.length(), &value));
+        ASSERT_CHECK_CALL(napi_get_value_string_latin1(env, value, buffer.data(), buffer.size(), &length));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+    }
+    ReportRate("latin1 string round trips", (double)BENCHMARK_ENCODE_COUNT, ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+        napi_value value = nullptr;
+        size_t length = 0;
+        ASSERT_CHECK_CALL(napi_create_string_utf8(env, utf8.c_str(), utf8.length(), &value));
+        ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, value, buffer.data(), buffer.size(), &length));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+    }
+    ReportRate("utf8 string round trips", (double)BENCHMARK_ENCODE_COUNT, ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+        napi_value value = nullptr;
+        size_t length = 0;
+        ASSERT_CHECK_CALL(napi_create_string_utf16(env, utf16.c_str(), utf16.length(), &value));
+        ASSERT_CHECK_CALL(napi_get_value_string_utf16(env, value, buffer16.data(), buffer16.size(), &length));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+    }
+    ReportRate("utf16 string round trips", (double)BENCHMARK_ENCODE_COUNT, ElapsedSeconds(start));
+
+    const char shortLatin1[] = "caf\xe9";
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value value = nullptr;
+            ASSERT_CHECK_CALL(napi_create_string_latin1(env, shortLatin1, sizeof(shortLatin1) - 1, &value));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+    }
+    ReportRate("short latin1 strings created", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+}
+
+/**
+ * @tc.name: FunctionCallBenchmark
+ * @tc.desc: Measure calls per second from JS into an empty native callback, with and without
+ *           reading the arguments.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, FunctionCallBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value global = nullptr;
+    ASSERT_CHECK_CALL(napi_get_global(env, &global));
+    napi_value emptyFunc = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function(env, "emptyCallback", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value { return nullptr; }, nullptr, &emptyFunc));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, global, "emptyCallback", emptyFunc));
+    napi_value readFunc = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function(env, "readCallback", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            size_t argc = 3;
+            napi_value argv[3] = { nullptr };
+            napi_value thisVar = nullptr;
+            napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+            return nullptr;
+        }, nullptr, &readFunc));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, global, "readCallback", readFunc));
+
+    std::string loop = "for (let i = 0; i < " + std::to_string(BENCHMARK_CALL_COUNT) + "; i++) ";
+    std::string scripts[] = {
+        loop + "{ emptyCallback(); }",
+        loop + "{ emptyCallback(i, i, i); }",
+        loop + "{ readCallback(i, i, i); }",
+    };
+    const char* names[] = {
+        "empty callback calls without arguments",
+        "empty callback calls with three arguments",
+        "callback calls reading three arguments",
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        napi_value script = nullptr;
+        ASSERT_CHECK_CALL(napi_create_string_utf8(env, scripts[i].c_str(), scripts[i].size(), &script));
+        napi_value result = nullptr;
+        auto start = BenchmarkClock::now();
+        ASSERT_CHECK_CALL(napi_run_script(env, script, &result));
+        ReportRate(names[i], (double)BENCHMARK_CALL_COUNT, ElapsedSeconds(start));
+    }
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: FunctionCreationBenchmark
+ * @tc.desc: Measure native function creation directly and from a template, and class definition with methods.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, FunctionCreationBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+    napi_callback callback = [](napi_env env, napi_callback_info info) -> napi_value { return nullptr; };
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        napi_open_handle_scope(env, &scope);
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value function = nullptr;
+            napi_create_function(env, "f", NAPI_AUTO_LENGTH, callback, nullptr, &function);
+        }
+        napi_close_handle_scope(env, scope);
+    }
+    ReportRate("functions created", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    napi_function_template functionTemplate = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function_template(env, callback, nullptr, &functionTemplate));
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope scope = nullptr;
+        napi_open_handle_scope(env, &scope);
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value function = nullptr;
+            napi_create_function_from_template(env, functionTemplate, &function);
+        }
+        napi_close_handle_scope(env, scope);
+    }
+    ReportRate("functions created from a template", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+    ASSERT_CHECK_CALL(napi_delete_function_template(env, functionTemplate));
+
+    // A module class with BENCHMARK_HANDLES_PER_SCOPE methods and as many getters.
+    std::vector<std::string> names;
+    std::vector<napi_property_descriptor> properties;
+    for (int i = 0; i < BENCHMARK_HANDLES_PER_SCOPE; i++) {
+        names.push_back("method" + std::to_string(i));
+        names.push_back("getter" + std::to_string(i));
+    }
+    for (int i = 0; i < BENCHMARK_HANDLES_PER_SCOPE; i++) {
+        properties.push_back({ names[2 * i].c_str(), nullptr, callback, nullptr, nullptr, nullptr, napi_default,
+                               nullptr });
+        properties.push_back({ names[2 * i + 1].c_str(), nullptr, nullptr, callback, nullptr, nullptr, napi_default,
+                               nullptr });
+    }
+    const int classCount = BENCHMARK_SCOPE_COUNT / 10;
+    start = BenchmarkClock::now();
+    for (int i = 0; i < classCount; i++) {
+        napi_handle_scope scope = nullptr;
+        napi_open_handle_scope(env, &scope);
+        napi_value moduleClass = nullptr;
+        napi_define_class(env, "ModuleClass", NAPI_AUTO_LENGTH, callback, nullptr, properties.size(),
+                          properties.data(), &moduleClass);
+        napi_close_handle_scope(env, scope);
+    }
+    ReportRate("classes defined", classCount, ElapsedSeconds(start));
+}
+
+/**
+ * @tc.name: PreparedCallBenchmark
+ * @tc.desc: Measure repeated calls of one JS listener through napi_call_function against a prepared call.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, PreparedCallBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "(function(event) { return event; })", NAPI_AUTO_LENGTH, &script));
+    napi_value listener = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &listener));
+    napi_value recv = nullptr;
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &recv));
+    napi_value event = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &event));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_call_function(env, recv, listener, 1, &event, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("napi_call_function calls", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    napi_prepared_call call = nullptr;
+    ASSERT_CHECK_CALL(napi_prepare_call(env, recv, listener, 1, &call));
+    ASSERT_CHECK_CALL(napi_set_prepared_call_argument(env, call, 0, event));
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_invoke_prepared_call(env, call, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("prepared calls", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE, ElapsedSeconds(start));
+    ASSERT_CHECK_CALL(napi_delete_prepared_call(env, call));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: ClassConstructionBenchmark
+ * @tc.desc: Measure constructing instances of a napi class against creating plain objects.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ClassConstructionBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value nativeClass = nullptr;
+    ASSERT_CHECK_CALL(napi_define_class(env, "BenchmarkClass", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            napi_value thisVar = nullptr;
+            napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        }, nullptr, 0, nullptr, &nativeClass));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_create_object(env, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("plain objects created", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_new_instance(env, nativeClass, 0, nullptr, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("class instances created", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: WrapBenchmark
+ * @tc.desc: Measure the memory held per wrapped object and the wrap and unwrap rates.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, WrapBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+    JSRuntime* runtime = JS_GetRuntime(static_cast<QuickJSNativeEngine*>(engine_)->GetContext());
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value wrapClass = nullptr;
+    ASSERT_CHECK_CALL(napi_define_class(env, "WrapBenchmarkClass", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            napi_value thisVar = nullptr;
+            napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        }, nullptr, 0, nullptr, &wrapClass));
+    const size_t count = (size_t)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE / 10;
+    napi_value instances = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array_with_length(env, count, &instances));
+    for (size_t i = 0; i < count; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        napi_value instance = nullptr;
+        ASSERT_CHECK_CALL(napi_new_instance(env, wrapClass, 0, nullptr, &instance));
+        ASSERT_CHECK_CALL(napi_set_element(env, instances, i, instance));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+
+    JSMemoryUsage before;
+    JS_ComputeMemoryUsage(runtime, &before);
+    auto start = BenchmarkClock::now();
+    static int nativeObject = 0;
+    for (size_t i = 0; i < count; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        napi_value instance = nullptr;
+        ASSERT_CHECK_CALL(napi_get_element(env, instances, i, &instance));
+        ASSERT_CHECK_CALL(napi_wrap(env, instance, &nativeObject,
+            [](napi_env env, void* data, void* hint) {}, nullptr, nullptr));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("objects wrapped", (double)count, ElapsedSeconds(start));
+    JSMemoryUsage after;
+    JS_ComputeMemoryUsage(runtime, &after);
+    printf("[ BENCHMARK ] wrap memory: %.1f bytes and %.2f allocations per wrapped object\n",
+           (double)(after.malloc_size - before.malloc_size) / count,
+           (double)(after.malloc_count - before.malloc_count) / count);
+
+    start = BenchmarkClock::now();
+    for (size_t i = 0; i < count; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        napi_value instance = nullptr;
+        void* result = nullptr;
+        ASSERT_CHECK_CALL(napi_get_element(env, instances, i, &instance));
+        ASSERT_CHECK_CALL(napi_unwrap(env, instance, &result));
+        ASSERT_EQ(result, &nativeObject);
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("objects unwrapped", (double)count, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: TaggedUnwrapBenchmark
+ * @tc.desc: Compare napi_unwrap_tagged with an unwrap checked through a marker property.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, TaggedUnwrapBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value tagClass = nullptr;
+    ASSERT_CHECK_CALL(napi_define_class(env, "TaggedUnwrapClass", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            napi_value thisVar = nullptr;
+            napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        }, nullptr, 0, nullptr, &tagClass));
+    napi_value instance = nullptr;
+    ASSERT_CHECK_CALL(napi_new_instance(env, tagClass, 0, nullptr, &instance));
+    static int nativeObject = 0;
+    ASSERT_CHECK_CALL(napi_wrap(env, instance, &nativeObject,
+        [](napi_env env, void* data, void* hint) {}, nullptr, nullptr));
+
+    const napi_type_tag tag = { 0x1f2e3d4c5b6a7988, 0x0123456789abcdef };
+    ASSERT_CHECK_CALL(napi_type_tag_object(env, instance, &tag));
+    napi_value marker = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "TaggedUnwrapClass", NAPI_AUTO_LENGTH, &marker));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, instance, "__type", marker));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_CALL_COUNT; i++) {
+        void* result = nullptr;
+        napi_unwrap_tagged(env, instance, &tag, &result);
+        ASSERT_EQ(result, &nativeObject);
+    }
+    ReportRate("tagged unwraps", BENCHMARK_CALL_COUNT, ElapsedSeconds(start));
+
+    const int markerCount = BENCHMARK_CALL_COUNT / 10;
+    start = BenchmarkClock::now();
+    for (int i = 0; i < markerCount; i++) {
+        napi_handle_scope innerScope = nullptr;
+        napi_open_handle_scope(env, &innerScope);
+        napi_value type = nullptr;
+        char buffer[32] = { 0 };
+        size_t length = 0;
+        napi_get_named_property(env, instance, "__type", &type);
+        napi_get_value_string_utf8(env, type, buffer, sizeof(buffer), &length);
+        void* result = nullptr;
+        if (strcmp(buffer, "TaggedUnwrapClass") == 0) {
+            napi_unwrap(env, instance, &result);
+        }
+        ASSERT_EQ(result, &nativeObject);
+        napi_close_handle_scope(env, innerScope);
+    }
+    ReportRate("marker checked unwraps", markerCount, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: NamedPropertyBenchmark
+ * @tc.desc: Measure property reads by C string name against reads through an interned property key.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, NamedPropertyBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value object = nullptr;
+    napi_value value = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &value));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, object, "benchmarkField", value));
+    napi_property_key key = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_key(env, "benchmarkField", NAPI_AUTO_LENGTH, &key));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_get_named_property(env, object, "benchmarkField", &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("named property reads", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_get_property_by_key(env, object, key, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("property key reads", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: PropertyCacheBenchmark
+ * @tc.desc: Measure reading one field from an array of same shaped objects through a property key
+ *           against reads through a property cache. The hit and miss counts show whether the
+ *           engine has an inline cache; QuickJS has none and misses on every read.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, PropertyCacheBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    const char* names[] = { "id", "name", "score", "weight" };
+    constexpr size_t fieldCount = sizeof(names) / sizeof(names[0]);
+    napi_property_key fieldKeys[fieldCount] = { nullptr };
+    for (size_t i = 0; i < fieldCount; i++) {
+        ASSERT_CHECK_CALL(napi_create_property_key(env, names[i], NAPI_AUTO_LENGTH, &fieldKeys[i]));
+    }
+    std::vector<napi_value> records(BENCHMARK_HANDLES_PER_SCOPE);
+    for (int i = 0; i < BENCHMARK_HANDLES_PER_SCOPE; i++) {
+        napi_value values[fieldCount] = { nullptr };
+        for (size_t j = 0; j < fieldCount; j++) {
+            ASSERT_CHECK_CALL(napi_create_int32(env, i + (int)j, &values[j]));
+        }
+        ASSERT_CHECK_CALL(napi_create_object(env, &records[i]));
+        ASSERT_CHECK_CALL(napi_set_named_properties(env, records[i], fieldKeys, values, fieldCount, nullptr));
+    }
+    napi_property_key key = fieldKeys[fieldCount - 1];
+    napi_property_cache cache = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_cache(env, key, &cache));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_get_property_by_key(env, records[j], key, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("property key reads", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value result = nullptr;
+            ASSERT_CHECK_CALL(napi_get_property_cached(env, records[j], cache, &result));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("property cache reads", (double)BENCHMARK_SCOPE_COUNT * BENCHMARK_HANDLES_PER_SCOPE,
+               ElapsedSeconds(start));
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    ASSERT_CHECK_CALL(napi_get_property_cache_stats(env, cache, &hits, &misses));
+    printf("[ BENCHMARK ] property cache: %llu hits, %llu misses\n", (unsigned long long)hits,
+           (unsigned long long)misses);
+    ASSERT_CHECK_CALL(napi_delete_property_cache(env, cache));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: ObjectTemplateBenchmark
+ * @tc.desc: Compare building result records field by field with building them from an object template.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ObjectTemplateBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+    const char* names[BENCHMARK_OPTION_COUNT] = {
+        "id", "name", "type", "size", "mode", "owner", "group", "created", "modified", "flags",
+    };
+    napi_value values[BENCHMARK_OPTION_COUNT] = { nullptr };
+    for (size_t i = 0; i < BENCHMARK_OPTION_COUNT; i++) {
+        ASSERT_CHECK_CALL(napi_create_uint32(env, i, &values[i]));
+    }
+
+    const int recordCount = BENCHMARK_SCOPE_COUNT * 10;
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < recordCount; i++) {
+        napi_handle_scope innerScope = nullptr;
+        napi_open_handle_scope(env, &innerScope);
+        napi_value record = nullptr;
+        napi_create_object(env, &record);
+        for (size_t j = 0; j < BENCHMARK_OPTION_COUNT; j++) {
+            napi_set_named_property(env, record, names[j], values[j]);
+        }
+        napi_close_handle_scope(env, innerScope);
+    }
+    ReportRate("records set field by field", recordCount, ElapsedSeconds(start));
+
+    napi_object_template objectTemplate = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object_template(env, names, BENCHMARK_OPTION_COUNT, &objectTemplate));
+    start = BenchmarkClock::now();
+    for (int i = 0; i < recordCount; i++) {
+        napi_handle_scope innerScope = nullptr;
+        napi_open_handle_scope(env, &innerScope);
+        napi_value record = nullptr;
+        napi_create_object_from_template(env, objectTemplate, values, &record);
+        napi_close_handle_scope(env, innerScope);
+    }
+    ReportRate("records created from a template", recordCount, ElapsedSeconds(start));
+    ASSERT_CHECK_CALL(napi_delete_object_template(env, objectTemplate));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: NamedPropertiesBenchmark
+ * @tc.desc: Measure reading a ten field options object per property against one batched read.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, NamedPropertiesBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    const char* names[BENCHMARK_OPTION_COUNT] = {
+        "width", "height", "x", "y", "title", "visible", "resizable", "opacity", "color", "z"
+    };
+    napi_property_key keys[BENCHMARK_OPTION_COUNT] = { nullptr };
+    napi_value values[BENCHMARK_OPTION_COUNT] = { nullptr };
+    for (size_t i = 0; i < BENCHMARK_OPTION_COUNT; i++) {
+        ASSERT_CHECK_CALL(napi_create_property_key(env, names[i], NAPI_AUTO_LENGTH, &keys[i]));
+        ASSERT_CHECK_CALL(napi_create_uint32(env, i, &values[i]));
+    }
+    napi_value options = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &options));
+    ASSERT_CHECK_CALL(napi_set_named_properties(env, options, keys, values, BENCHMARK_OPTION_COUNT, nullptr));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (size_t j = 0; j < BENCHMARK_OPTION_COUNT; j++) {
+            ASSERT_CHECK_CALL(napi_get_named_property(env, options, names[j], &values[j]));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("options reads per property", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        ASSERT_CHECK_CALL(napi_get_named_properties(env, options, keys, BENCHMARK_OPTION_COUNT, values, nullptr));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("options reads batched", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: ArrayElementsBenchmark
+ * @tc.desc: Measure building a 100 element array with napi_set_element against napi_create_array_with_elements.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ArrayElementsBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value values[BENCHMARK_HANDLES_PER_SCOPE] = { nullptr };
+    for (int i = 0; i < BENCHMARK_HANDLES_PER_SCOPE; i++) {
+        ASSERT_CHECK_CALL(napi_create_int32(env, i, &values[i]));
+    }
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        napi_value array = nullptr;
+        ASSERT_CHECK_CALL(napi_create_array_with_length(env, BENCHMARK_HANDLES_PER_SCOPE, &array));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            ASSERT_CHECK_CALL(napi_set_element(env, array, j, values[j]));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("arrays built per element", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        napi_value array = nullptr;
+        ASSERT_CHECK_CALL(napi_create_array_with_elements(env, values, BENCHMARK_HANDLES_PER_SCOPE, &array));
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("arrays built in bulk", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: ArrayNumbersBenchmark
+ * @tc.desc: Measure converting a 100 element number array per element against napi_get_array_numbers.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ArrayNumbersBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    double numbers[BENCHMARK_HANDLES_PER_SCOPE] = { 0 };
+    for (int i = 0; i < BENCHMARK_HANDLES_PER_SCOPE; i++) {
+        numbers[i] = i * 0.5;
+    }
+    napi_value array = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array_from_numbers(env, napi_float64_array, numbers, BENCHMARK_HANDLES_PER_SCOPE,
+                                                     &array));
+
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        for (int j = 0; j < BENCHMARK_HANDLES_PER_SCOPE; j++) {
+            napi_value element = nullptr;
+            ASSERT_CHECK_CALL(napi_get_element(env, array, j, &element));
+            ASSERT_CHECK_CALL(napi_get_value_double(env, element, &numbers[j]));
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("number arrays converted per element", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_SCOPE_COUNT; i++) {
+        size_t invalidCount = 0;
+        ASSERT_CHECK_CALL(napi_get_array_numbers(env, array, napi_float64_array, numbers,
+                                                 BENCHMARK_HANDLES_PER_SCOPE, nullptr, 0, &invalidCount));
+    }
+    ReportRate("number arrays converted in bulk", (double)BENCHMARK_SCOPE_COUNT, ElapsedSeconds(start));
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: ObjectForEachBenchmark
+ * @tc.desc: Measure reading a 100 property object through napi_get_property_names against napi_object_for_each.
+ * @tc.type: PERF
+ */
+HWTEST_F(NativeEngineTest, ObjectForEachBenchmark, testing::ext::TestSize.Level1)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    for (int i = 0; i < BENCHMARK_HANDLES_PER_SCOPE; i++) {
+        std::string name = "field" + std::to_string(i);
+        napi_value value = nullptr;
+        ASSERT_CHECK_CALL(napi_create_int32(env, i, &value));
+        ASSERT_CHECK_CALL(napi_set_named_property(env, object, name.c_str(), value));
+    }
+
+    int64_t sum = 0;
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+        napi_handle_scope innerScope = nullptr;
+        ASSERT_CHECK_CALL(napi_open_handle_scope(env, &innerScope));
+        napi_value names = nullptr;
+        uint32_t length = 0;
+        ASSERT_CHECK_CALL(napi_get_property_names(env, object, &names));
+        ASSERT_CHECK_CALL(napi_get_array_length(env, names, &length));
+        for (uint32_t j = 0; j < length; j++) {
+            napi_value name = nullptr;
+            napi_value value = nullptr;
+            int32_t number = 0;
+            ASSERT_CHECK_CALL(napi_get_element(env, names, j, &name));
+            ASSERT_CHECK_CALL(napi_get_property(env, object, name, &value));
+            ASSERT_CHECK_CALL(napi_get_value_int32(env, value, &number));
+            sum += number;
+        }
+        ASSERT_CHECK_CALL(napi_close_handle_scope(env, innerScope));
+    }
+    ReportRate("objects read through property names", (double)BENCHMARK_ENCODE_COUNT, ElapsedSeconds(start));
+
+    start = BenchmarkClock::now();
+    for (int i = 0; i < BENCHMARK_ENCODE_COUNT; i++) {
+        ASSERT_CHECK_CALL(napi_object_for_each(env, object,
+            [](napi_env env, napi_value key, napi_value value, void* data) -> bool {
+                int32_t number = 0;
+                napi_get_value_int32(env, value, &number);
+                *reinterpret_cast<int64_t*>(data) += number;
+                return true;
+            }, &sum));
+    }
+    ReportRate("objects read through for each", (double)BENCHMARK_ENCODE_COUNT, ElapsedSeconds(start));
+    ASSERT_GT(sum, 0);
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
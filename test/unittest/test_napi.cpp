@@ -15,6 +15,9 @@
 
 #include "test.h"
 
+#include <cmath>
+#include <string>
+
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 
@@ -154,6 +157,103 @@ HWTEST_F(NativeEngineTest, StringTest, testing::ext::TestSize.Level0)
     buffer = nullptr;
 }
 
+/**
+ * @tc.name: StringViewTest
+ * @tc.desc: Test string length and borrowed string view.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, StringViewTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    const char testStr[] = "\xc3\xa9t\xc3\xa9 \xe2\x98\x80 \xf0\x9f\x98\x80 ascii";
+    size_t testStrLength = strlen(testStr);
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, testStr, testStrLength, &result));
+
+    size_t bufferSize = 0;
+    ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, result, nullptr, 0, &bufferSize));
+    ASSERT_EQ(bufferSize, testStrLength);
+
+    const char* view = nullptr;
+    size_t viewLength = 0;
+    ASSERT_CHECK_CALL(napi_get_value_string_utf8_view(env, result, &view, &viewLength));
+    ASSERT_EQ(viewLength, testStrLength);
+    ASSERT_EQ(memcmp(view, testStr, testStrLength), 0);
+
+    const char* secondView = nullptr;
+    ASSERT_CHECK_CALL(napi_get_value_string_utf8_view(env, result, &secondView, nullptr));
+    ASSERT_EQ(view, secondView);
+
+    napi_value number = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &number));
+    ASSERT_EQ(napi_get_value_string_utf8_view(env, number, &view, &viewLength), napi_string_expected);
+}
+
+/**
+ * @tc.name: StringLatin1Test
+ * @tc.desc: Test latin1 string create and get.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, StringLatin1Test, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    const char testStr[] = "caf\xe9 \xa9 \xff";
+    size_t testStrLength = strlen(testStr);
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_latin1(env, testStr, NAPI_AUTO_LENGTH, &result));
+    ASSERT_CHECK_VALUE_TYPE(env, result, napi_string);
+
+    size_t bufferSize = 0;
+    ASSERT_CHECK_CALL(napi_get_value_string_latin1(env, result, nullptr, 0, &bufferSize));
+    ASSERT_EQ(bufferSize, testStrLength);
+    char buffer[sizeof(testStr)] = { 0 };
+    size_t strLength = 0;
+    ASSERT_CHECK_CALL(napi_get_value_string_latin1(env, result, buffer, sizeof(buffer), &strLength));
+    ASSERT_EQ(strLength, testStrLength);
+    ASSERT_STREQ(buffer, testStr);
+
+    ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, result, nullptr, 0, &bufferSize));
+    ASSERT_EQ(bufferSize, testStrLength + 3);
+
+    ASSERT_CHECK_CALL(napi_get_value_string_latin1(env, result, buffer, 4, &strLength));
+    ASSERT_EQ(strLength, (size_t)3);
+    ASSERT_STREQ(buffer, "caf");
+}
+
+/**
+ * @tc.name: StringUtf16Test
+ * @tc.desc: Test utf16 string create and get.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, StringUtf16Test, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    const char16_t testStr[] = u"\u4e2d\u6587,English,\U0001F600";
+    size_t testStrLength = std::char_traits<char16_t>::length(testStr);
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf16(env, testStr, NAPI_AUTO_LENGTH, &result));
+    ASSERT_CHECK_VALUE_TYPE(env, result, napi_string);
+
+    size_t bufferSize = 0;
+    ASSERT_CHECK_CALL(napi_get_value_string_utf16(env, result, nullptr, 0, &bufferSize));
+    ASSERT_EQ(bufferSize, testStrLength);
+    char16_t buffer[sizeof(testStr) / sizeof(char16_t)] = { 0 };
+    size_t strLength = 0;
+    ASSERT_CHECK_CALL(napi_get_value_string_utf16(env, result, buffer, bufferSize + 1, &strLength));
+    ASSERT_EQ(strLength, testStrLength);
+    ASSERT_EQ(std::u16string(buffer), std::u16string(testStr));
+
+    char utf8[32] = { 0 };
+    ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, result, utf8, sizeof(utf8), &strLength));
+    ASSERT_STREQ(utf8, "\xe4\xb8\xad\xe6\x96\x87,English,\xf0\x9f\x98\x80");
+
+    napi_value ascii = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "ascii", NAPI_AUTO_LENGTH, &ascii));
+    ASSERT_CHECK_CALL(napi_get_value_string_utf16(env, ascii, buffer, 3, &strLength));
+    ASSERT_EQ(strLength, (size_t)2);
+    ASSERT_EQ(std::u16string(buffer), std::u16string(u"as"));
+}
+
 /**
  * @tc.name: SymbolTest
  * @tc.desc: Test symbol type.
@@ -196,6 +296,51 @@ HWTEST_F(NativeEngineTest, ExternalTest, testing::ext::TestSize.Level0)
     ASSERT_EQ(tmpExternal, testStr);
 }
 
+/**
+ * @tc.name: ExternalGlobalTest
+ * @tc.desc: Test externals do not depend on the global External binding.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, ExternalGlobalTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    const char* source = "External = function() { throw new Error('patched'); };"
+                         "globalThis.External = null;"
+                         "typeof External === 'function';";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &result));
+    bool unchanged = false;
+    ASSERT_CHECK_CALL(napi_get_value_bool(env, result, &unchanged));
+    ASSERT_TRUE(unchanged);
+
+    static int nativeObject = 0;
+    napi_value external = nullptr;
+    ASSERT_CHECK_CALL(napi_create_external(env, &nativeObject, [](napi_env env, void* data, void* hint) {},
+                                           nullptr, &external));
+    ASSERT_CHECK_VALUE_TYPE(env, external, napi_external);
+    void* data = nullptr;
+    ASSERT_CHECK_CALL(napi_get_value_external(env, external, &data));
+    ASSERT_EQ(data, &nativeObject);
+
+    // Scripts may still construct externals, which carry no native pointer.
+    napi_value global = nullptr;
+    ASSERT_CHECK_CALL(napi_get_global(env, &global));
+    napi_value constructor = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, global, "External", &constructor));
+    napi_value instance = nullptr;
+    ASSERT_CHECK_CALL(napi_new_instance(env, constructor, 0, nullptr, &instance));
+    ASSERT_CHECK_VALUE_TYPE(env, instance, napi_external);
+    ASSERT_CHECK_CALL(napi_get_value_external(env, instance, &data));
+    ASSERT_EQ(data, nullptr);
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    ASSERT_EQ(napi_get_value_external(env, object, &data), napi_object_expected);
+}
+
 /**
  * @tc.name: ObjectTest
  * @tc.desc: Test object type.
@@ -260,6 +405,325 @@ HWTEST_F(NativeEngineTest, ObjectTest, testing::ext::TestSize.Level0)
     }
 }
 
+/**
+ * @tc.name: AllPropertyNamesTest
+ * @tc.desc: Test napi_get_all_property_names key filters and conversion.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, AllPropertyNamesTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value prototype = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &prototype));
+    napi_value value = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &value));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, prototype, "inherited", value));
+
+    napi_value global = nullptr;
+    ASSERT_CHECK_CALL(napi_get_global(env, &global));
+    napi_value objectConstructor = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, global, "Object", &objectConstructor));
+    napi_value create = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, objectConstructor, "create", &create));
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_call_function(env, objectConstructor, create, 1, &prototype, &object));
+
+    ASSERT_CHECK_CALL(napi_set_named_property(env, object, "own", value));
+    ASSERT_CHECK_CALL(napi_set_element(env, object, 3, value));
+    napi_value description = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "symbol", NAPI_AUTO_LENGTH, &description));
+    napi_value symbol = nullptr;
+    ASSERT_CHECK_CALL(napi_create_symbol(env, description, &symbol));
+    ASSERT_CHECK_CALL(napi_set_property(env, object, symbol, value));
+    napi_property_descriptor desc[] = {
+        DECLARE_NAPI_FUNCTION("hidden", [](napi_env env, napi_callback_info info) -> napi_value { return nullptr; }),
+    };
+    ASSERT_CHECK_CALL(napi_define_properties(env, object, 1, desc));
+
+    napi_value names = nullptr;
+    uint32_t length = 0;
+    ASSERT_CHECK_CALL(napi_get_all_property_names(env, object, napi_key_own_only, napi_key_all_properties,
+                                                  napi_key_keep_numbers, &names));
+    ASSERT_CHECK_CALL(napi_get_array_length(env, names, &length));
+    ASSERT_EQ(length, (uint32_t)4);
+
+    ASSERT_CHECK_CALL(napi_get_all_property_names(env, object, napi_key_own_only,
+        (napi_key_filter)(napi_key_enumerable | napi_key_skip_symbols), napi_key_keep_numbers, &names));
+    ASSERT_CHECK_CALL(napi_get_array_length(env, names, &length));
+    ASSERT_EQ(length, (uint32_t)2);
+    napi_value name = nullptr;
+    ASSERT_CHECK_CALL(napi_get_element(env, names, 0, &name));
+    ASSERT_CHECK_VALUE_TYPE(env, name, napi_number);
+
+    ASSERT_CHECK_CALL(napi_get_all_property_names(env, object, napi_key_own_only,
+        (napi_key_filter)(napi_key_enumerable | napi_key_skip_symbols), napi_key_numbers_to_strings, &names));
+    ASSERT_CHECK_CALL(napi_get_element(env, names, 0, &name));
+    ASSERT_CHECK_VALUE_TYPE(env, name, napi_string);
+
+    ASSERT_CHECK_CALL(napi_get_all_property_names(env, object, napi_key_own_only, napi_key_skip_strings,
+                                                  napi_key_keep_numbers, &names));
+    ASSERT_CHECK_CALL(napi_get_array_length(env, names, &length));
+    ASSERT_EQ(length, (uint32_t)1);
+    ASSERT_CHECK_CALL(napi_get_element(env, names, 0, &name));
+    ASSERT_CHECK_VALUE_TYPE(env, name, napi_symbol);
+
+    // The non-enumerable own "hidden" shadows the enumerable one of the prototype.
+    ASSERT_CHECK_CALL(napi_set_named_property(env, prototype, "hidden", value));
+    ASSERT_CHECK_CALL(napi_get_all_property_names(env, object, napi_key_include_prototypes,
+        (napi_key_filter)(napi_key_enumerable | napi_key_skip_symbols), napi_key_numbers_to_strings, &names));
+    ASSERT_CHECK_CALL(napi_get_array_length(env, names, &length));
+    ASSERT_EQ(length, (uint32_t)3);
+}
+
+/**
+ * @tc.name: ObjectForEachTest
+ * @tc.desc: Test napi_object_for_each visits own enumerable properties and can stop early.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, ObjectForEachTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    const char* names[] = { "a", "b", "c" };
+    napi_property_key keys[3] = { nullptr };
+    napi_value values[3] = { nullptr };
+    for (int32_t i = 0; i < 3; i++) {
+        ASSERT_CHECK_CALL(napi_create_property_key(env, names[i], NAPI_AUTO_LENGTH, &keys[i]));
+        ASSERT_CHECK_CALL(napi_create_int32(env, i + 1, &values[i]));
+    }
+    ASSERT_CHECK_CALL(napi_set_named_properties(env, object, keys, values, 3, nullptr));
+
+    struct Visit {
+        int32_t sum = 0;
+        int count = 0;
+        int limit = 0;
+    } visit;
+    auto iterator = [](napi_env env, napi_value key, napi_value value, void* data) -> bool {
+        auto visit = reinterpret_cast<Visit*>(data);
+        napi_valuetype keyType = napi_undefined;
+        napi_typeof(env, key, &keyType);
+        int32_t number = 0;
+        napi_get_value_int32(env, value, &number);
+        if (keyType == napi_string) {
+            visit->sum += number;
+        }
+        return ++visit->count != visit->limit;
+    };
+
+    ASSERT_CHECK_CALL(napi_object_for_each(env, object, iterator, &visit));
+    ASSERT_EQ(visit.count, 3);
+    ASSERT_EQ(visit.sum, 6);
+
+    visit = Visit();
+    visit.limit = 2;
+    ASSERT_CHECK_CALL(napi_object_for_each(env, object, iterator, &visit));
+    ASSERT_EQ(visit.count, 2);
+    ASSERT_EQ(visit.sum, 3);
+
+    // A throwing getter ends the iteration with an error.
+    const char* source = "({ a: 1, get b() { throw new Error('b'); }, c: 3 })";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value throwing = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &throwing));
+    visit = Visit();
+    ASSERT_EQ(napi_object_for_each(env, throwing, iterator, &visit), napi_pending_exception);
+    ASSERT_EQ(visit.count, 1);
+    ASSERT_EQ(visit.sum, 1);
+}
+
+/**
+ * @tc.name: PropertyKeyTest
+ * @tc.desc: Test property access through interned property keys.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, PropertyKeyTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_property_key key = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_key(env, "keyAttribute", NAPI_AUTO_LENGTH, &key));
+    napi_property_key sameKey = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_key(env, "keyAttribute", strlen("keyAttribute"), &sameKey));
+    ASSERT_EQ(key, sameKey);
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    bool hasProperty = true;
+    ASSERT_CHECK_CALL(napi_has_property_by_key(env, object, key, &hasProperty));
+    ASSERT_FALSE(hasProperty);
+
+    napi_value value = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1234, &value));
+    ASSERT_CHECK_CALL(napi_set_property_by_key(env, object, key, value));
+    ASSERT_CHECK_CALL(napi_has_property_by_key(env, object, key, &hasProperty));
+    ASSERT_TRUE(hasProperty);
+
+    napi_value namedValue = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, object, "keyAttribute", &namedValue));
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, namedValue, &number));
+    ASSERT_EQ(number, 1234);
+
+    napi_value keyValue = nullptr;
+    ASSERT_CHECK_CALL(napi_get_property_by_key(env, object, key, &keyValue));
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, keyValue, &number));
+    ASSERT_EQ(number, 1234);
+
+    bool deleted = false;
+    ASSERT_CHECK_CALL(napi_delete_property_by_key(env, object, key, &deleted));
+    ASSERT_TRUE(deleted);
+    ASSERT_CHECK_CALL(napi_has_property_by_key(env, object, key, &hasProperty));
+    ASSERT_FALSE(hasProperty);
+
+    ASSERT_EQ(napi_get_property_by_key(env, value, key, &keyValue), napi_object_expected);
+}
+
+/**
+ * @tc.name: PropertyCacheTest
+ * @tc.desc: Test property reads through a property cache across object shapes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, PropertyCacheTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_property_key key = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_key(env, "x", NAPI_AUTO_LENGTH, &key));
+    napi_property_cache cache = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_cache(env, key, &cache));
+
+    napi_property_key otherKey = nullptr;
+    ASSERT_CHECK_CALL(napi_create_property_key(env, "y", NAPI_AUTO_LENGTH, &otherKey));
+    napi_property_key keys[] = { key, otherKey };
+    napi_property_key reversedKeys[] = { otherKey, key };
+    napi_value objects[4] = { nullptr };
+    for (int32_t i = 0; i < 4; i++) {
+        napi_value values[2] = { nullptr };
+        ASSERT_CHECK_CALL(napi_create_int32(env, i, &values[0]));
+        ASSERT_CHECK_CALL(napi_create_int32(env, -i, &values[1]));
+        ASSERT_CHECK_CALL(napi_create_object(env, &objects[i]));
+        // The last object gets the same fields in another order, so another shape.
+        napi_value orderedValues[2] = { (i < 3) ? values[0] : values[1], (i < 3) ? values[1] : values[0] };
+        ASSERT_CHECK_CALL(
+            napi_set_named_properties(env, objects[i], (i < 3) ? keys : reversedKeys, orderedValues, 2, nullptr));
+    }
+
+    for (int32_t i = 0; i < 4; i++) {
+        napi_value result = nullptr;
+        int32_t number = -1;
+        ASSERT_CHECK_CALL(napi_get_property_cached(env, objects[i], cache, &result));
+        ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &number));
+        ASSERT_EQ(number, i);
+    }
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    ASSERT_CHECK_CALL(napi_get_property_cache_stats(env, cache, &hits, &misses));
+    ASSERT_EQ(hits + misses, (uint64_t)4);
+    ASSERT_GE(misses, (uint64_t)2);
+
+    // Accessors and missing properties are read like any other property.
+    napi_value accessorObject = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &accessorObject));
+    napi_property_descriptor desc[] = {
+        { "x", nullptr, nullptr,
+          [](napi_env env, napi_callback_info info) -> napi_value {
+              napi_value result = nullptr;
+              napi_create_int32(env, 42, &result);
+              return result;
+          },
+          nullptr, nullptr, napi_default, nullptr },
+    };
+    ASSERT_CHECK_CALL(napi_define_properties(env, accessorObject, 1, desc));
+    napi_value result = nullptr;
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_property_cached(env, accessorObject, cache, &result));
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &number));
+    ASSERT_EQ(number, 42);
+
+    napi_value emptyObject = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &emptyObject));
+    ASSERT_CHECK_CALL(napi_get_property_cached(env, emptyObject, cache, &result));
+    ASSERT_CHECK_VALUE_TYPE(env, result, napi_undefined);
+
+    // A property written after the first read is seen by the next one.
+    ASSERT_CHECK_CALL(napi_get_property_cached(env, objects[0], cache, &result));
+    napi_value newValue = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 100, &newValue));
+    ASSERT_CHECK_CALL(napi_set_property_by_key(env, objects[0], key, newValue));
+    ASSERT_CHECK_CALL(napi_get_property_cached(env, objects[0], cache, &result));
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &number));
+    ASSERT_EQ(number, 100);
+
+    ASSERT_EQ(napi_get_property_cached(env, newValue, cache, &result), napi_object_expected);
+    ASSERT_CHECK_CALL(napi_delete_property_cache(env, cache));
+}
+
+/**
+ * @tc.name: NamedPropertiesTest
+ * @tc.desc: Test batched named property get and set.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, NamedPropertiesTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+
+    const char* names[] = { "width", "height", "title", "missing", "a", "b", "c" };
+    constexpr size_t keyCount = sizeof(names) / sizeof(names[0]);
+    napi_property_key keys[keyCount] = { nullptr };
+    for (size_t i = 0; i < keyCount; i++) {
+        ASSERT_CHECK_CALL(napi_create_property_key(env, names[i], NAPI_AUTO_LENGTH, &keys[i]));
+    }
+
+    napi_value values[3] = { nullptr };
+    ASSERT_CHECK_CALL(napi_create_int32(env, 640, &values[0]));
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &values[1]));
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "window", NAPI_AUTO_LENGTH, &values[2]));
+    bool setResults[3] = { false };
+    ASSERT_CHECK_CALL(napi_set_named_properties(env, object, keys, values, 3, setResults));
+    ASSERT_TRUE(setResults[0] && setResults[1] && setResults[2]);
+
+    // A property holding undefined is found, a missing one is not.
+    napi_property_key readKeys[] = { keys[1], keys[3], keys[2] };
+    napi_value results[3] = { nullptr };
+    bool found[3] = { false };
+    ASSERT_CHECK_CALL(napi_get_named_properties(env, object, readKeys, 3, results, found));
+    ASSERT_CHECK_VALUE_TYPE(env, results[0], napi_undefined);
+    ASSERT_CHECK_VALUE_TYPE(env, results[1], napi_undefined);
+    ASSERT_CHECK_VALUE_TYPE(env, results[2], napi_string);
+    ASSERT_TRUE(found[0]);
+    ASSERT_FALSE(found[1]);
+    ASSERT_TRUE(found[2]);
+
+    // Both stop at the first accessor that throws.
+    const char* source = "({ a: 1, get b() { throw new Error('get'); }, set b(v) { throw new Error('set'); }, c: 3 })";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value throwing = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &throwing));
+    napi_value throwingResults[3] = { nullptr };
+    ASSERT_EQ(napi_get_named_properties(env, throwing, keys + 4, 3, throwingResults, nullptr),
+              napi_pending_exception);
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, throwingResults[0], &number));
+    ASSERT_EQ(number, 1);
+    ASSERT_EQ(throwingResults[2], nullptr);
+    napi_value newValues[3] = { values[0], values[0], values[0] };
+    ASSERT_EQ(napi_set_named_properties(env, throwing, keys + 4, newValues, 3, nullptr), napi_pending_exception);
+    napi_value c = nullptr;
+    ASSERT_CHECK_CALL(napi_get_property_by_key(env, throwing, keys[6], &c));
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, c, &number));
+    ASSERT_EQ(number, 3);
+
+    ASSERT_EQ(napi_get_named_properties(env, values[0], readKeys, 3, results, nullptr), napi_object_expected);
+}
+
 /**
  * @tc.name: FunctionTest
  * @tc.desc: Test function type.
@@ -327,6 +791,157 @@ HWTEST_F(NativeEngineTest, FunctionTest, testing::ext::TestSize.Level0)
     napi_close_handle_scope(env, parentScope);
 }
 
+/**
+ * @tc.name: CallbackInfoTest
+ * @tc.desc: Test reading part of the arguments and the receiver through napi_get_cb_info.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, CallbackInfoTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    struct Observed {
+        size_t argc = 0;
+        int32_t first = 0;
+        int32_t last = 0;
+        napi_valuetype thisType = napi_undefined;
+    } observed;
+
+    auto func = [](napi_env env, napi_callback_info info) -> napi_value {
+        size_t argc = 0;
+        void* data = nullptr;
+        napi_get_cb_info(env, info, &argc, nullptr, nullptr, &data);
+        auto observed = reinterpret_cast<Observed*>(data);
+        observed->argc = argc;
+
+        // Only the first argument is asked for.
+        size_t firstCount = 1;
+        napi_value first = nullptr;
+        napi_get_cb_info(env, info, &firstCount, &first, nullptr, nullptr);
+        napi_get_value_int32(env, first, &observed->first);
+
+        // Arguments read inside a nested scope stay valid within that scope.
+        napi_handle_scope scope = nullptr;
+        napi_open_handle_scope(env, &scope);
+        napi_value argv[4] = { nullptr };
+        size_t count = 4;
+        napi_value thisVar = nullptr;
+        napi_get_cb_info(env, info, &count, argv, &thisVar, nullptr);
+        napi_get_value_int32(env, argv[count - 1], &observed->last);
+        napi_typeof(env, thisVar, &observed->thisType);
+        napi_close_handle_scope(env, scope);
+
+        return first;
+    };
+
+    napi_value funcValue = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function(env, "callbackInfoFunc", NAPI_AUTO_LENGTH, func, &observed, &funcValue));
+
+    napi_value recv = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &recv));
+    napi_value args[3] = { nullptr };
+    for (int32_t i = 0; i < 3; i++) {
+        ASSERT_CHECK_CALL(napi_create_int32(env, i + 10, &args[i]));
+    }
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_call_function(env, recv, funcValue, 3, args, &result));
+
+    ASSERT_EQ(observed.argc, (size_t)3);
+    ASSERT_EQ(observed.first, 10);
+    ASSERT_EQ(observed.last, 12);
+    ASSERT_EQ(observed.thisType, napi_object);
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &number));
+    ASSERT_EQ(number, 10);
+}
+
+/**
+ * @tc.name: PreparedCallTest
+ * @tc.desc: Test calling a JS function repeatedly through a prepared call frame.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, PreparedCallTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    const char* source = "(function(a, b) { return this.base + a + b; })";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value func = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &func));
+    ASSERT_CHECK_VALUE_TYPE(env, func, napi_function);
+
+    napi_value recv = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &recv));
+    napi_value base = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 100, &base));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, recv, "base", base));
+
+    napi_prepared_call call = nullptr;
+    ASSERT_CHECK_CALL(napi_prepare_call(env, recv, func, 2, &call));
+
+    napi_value first = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &first));
+    ASSERT_CHECK_CALL(napi_set_prepared_call_argument(env, call, 0, first));
+    for (int32_t i = 0; i < 3; i++) {
+        napi_value second = nullptr;
+        ASSERT_CHECK_CALL(napi_create_int32(env, i, &second));
+        ASSERT_CHECK_CALL(napi_set_prepared_call_argument(env, call, 1, second));
+        napi_value result = nullptr;
+        ASSERT_CHECK_CALL(napi_invoke_prepared_call(env, call, &result));
+        int32_t number = 0;
+        ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &number));
+        ASSERT_EQ(number, 101 + i);
+    }
+
+    ASSERT_EQ(napi_set_prepared_call_argument(env, call, 2, first), napi_invalid_arg);
+    ASSERT_CHECK_CALL(napi_delete_prepared_call(env, call));
+
+    ASSERT_EQ(napi_prepare_call(env, recv, recv, 0, &call), napi_function_expected);
+}
+
+/**
+ * @tc.name: PreparedCallReleaseTest
+ * @tc.desc: Test a called listener deleting its own prepared call while it runs.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, PreparedCallReleaseTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    struct Listener {
+        napi_prepared_call call = nullptr;
+        napi_status status = napi_generic_failure;
+    } listener;
+
+    auto func = [](napi_env env, napi_callback_info info) -> napi_value {
+        void* data = nullptr;
+        napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data);
+        auto listener = reinterpret_cast<Listener*>(data);
+        listener->status = napi_delete_prepared_call(env, listener->call);
+        listener->call = nullptr;
+
+        napi_value result = nullptr;
+        napi_create_int32(env, 7, &result);
+        return result;
+    };
+
+    napi_value funcValue = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function(env, "offFunc", NAPI_AUTO_LENGTH, func, &listener, &funcValue));
+    ASSERT_CHECK_CALL(napi_prepare_call(env, nullptr, funcValue, 1, &listener.call));
+    napi_value argument = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &argument));
+    ASSERT_CHECK_CALL(napi_set_prepared_call_argument(env, listener.call, 0, argument));
+
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_invoke_prepared_call(env, listener.call, &result));
+    ASSERT_EQ(listener.status, napi_ok);
+    ASSERT_EQ(listener.call, nullptr);
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &number));
+    ASSERT_EQ(number, 7);
+}
+
 /**
  * @tc.name: ArrayTest
  * @tc.desc: Test array type.
@@ -366,6 +981,206 @@ HWTEST_F(NativeEngineTest, ArrayTest, testing::ext::TestSize.Level0) {
     }
 }
 
+/**
+ * @tc.name: DeleteElementTest
+ * @tc.desc: Test napi_delete_element deletes in place and keeps the array identity.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, DeleteElementTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value array = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array(env, &array));
+    for (uint32_t i = 0; i < 3; i++) {
+        napi_value num = nullptr;
+        ASSERT_CHECK_CALL(napi_create_uint32(env, i, &num));
+        ASSERT_CHECK_CALL(napi_set_element(env, array, i, num));
+    }
+    napi_value holder = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &holder));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, holder, "array", array));
+
+    bool isDelete = false;
+    ASSERT_CHECK_CALL(napi_delete_element(env, array, 1, &isDelete));
+    ASSERT_TRUE(isDelete);
+
+    napi_value heldArray = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, holder, "array", &heldArray));
+    bool isEquals = false;
+    ASSERT_CHECK_CALL(napi_strict_equals(env, array, heldArray, &isEquals));
+    ASSERT_TRUE(isEquals);
+
+    bool hasElement = true;
+    ASSERT_CHECK_CALL(napi_has_element(env, heldArray, 1, &hasElement));
+    ASSERT_FALSE(hasElement);
+    ASSERT_CHECK_CALL(napi_has_element(env, heldArray, 2, &hasElement));
+    ASSERT_TRUE(hasElement);
+    uint32_t arrayLength = 0;
+    ASSERT_CHECK_CALL(napi_get_array_length(env, array, &arrayLength));
+    ASSERT_EQ(arrayLength, (uint32_t)3);
+
+    ASSERT_CHECK_CALL(napi_delete_element(env, array, 10, &isDelete));
+    ASSERT_TRUE(isDelete);
+}
+
+/**
+ * @tc.name: ArrayElementsTest
+ * @tc.desc: Test bulk array element get and set.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, ArrayElementsTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value values[4] = { nullptr };
+    for (int32_t i = 0; i < 4; i++) {
+        ASSERT_CHECK_CALL(napi_create_int32(env, i * 10, &values[i]));
+    }
+
+    napi_value array = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array_with_elements(env, values, 4, &array));
+    bool isArray = false;
+    ASSERT_CHECK_CALL(napi_is_array(env, array, &isArray));
+    ASSERT_TRUE(isArray);
+    uint32_t length = 0;
+    ASSERT_CHECK_CALL(napi_get_array_length(env, array, &length));
+    ASSERT_EQ(length, (uint32_t)4);
+
+    ASSERT_CHECK_CALL(napi_set_elements(env, array, 3, values, 2));
+    ASSERT_CHECK_CALL(napi_get_array_length(env, array, &length));
+    ASSERT_EQ(length, (uint32_t)5);
+
+    napi_value results[5] = { nullptr };
+    ASSERT_CHECK_CALL(napi_get_elements(env, array, 0, 5, results));
+    const int32_t expected[] = { 0, 10, 20, 0, 10 };
+    for (size_t i = 0; i < 5; i++) {
+        int32_t number = -1;
+        ASSERT_CHECK_CALL(napi_get_value_int32(env, results[i], &number));
+        ASSERT_EQ(number, expected[i]);
+    }
+
+    ASSERT_CHECK_CALL(napi_get_elements(env, array, 4, 2, results));
+    ASSERT_CHECK_VALUE_TYPE(env, results[1], napi_undefined);
+
+    napi_value emptyArray = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array_with_elements(env, nullptr, 0, &emptyArray));
+    ASSERT_CHECK_CALL(napi_get_array_length(env, emptyArray, &length));
+    ASSERT_EQ(length, (uint32_t)0);
+
+    // Both stop at the first accessor that throws.
+    const char* source = "(function() { const a = [1, 2, 3]; Object.defineProperty(a, 1, "
+                         "{ get() { throw new Error('get'); }, set(v) { throw new Error('set'); } }); return a; })()";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value throwing = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &throwing));
+    napi_value throwingResults[3] = { nullptr };
+    ASSERT_EQ(napi_get_elements(env, throwing, 0, 3, throwingResults), napi_pending_exception);
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, throwingResults[0], &number));
+    ASSERT_EQ(number, 1);
+    ASSERT_EQ(throwingResults[2], nullptr);
+    ASSERT_EQ(napi_set_elements(env, throwing, 0, values, 3), napi_pending_exception);
+    ASSERT_CHECK_CALL(napi_get_element(env, throwing, 2, &throwingResults[2]));
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, throwingResults[2], &number));
+    ASSERT_EQ(number, 3);
+
+    // Writing a read-only element throws as well.
+    napi_value frozenScript = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "Object.freeze([1, 2])", NAPI_AUTO_LENGTH, &frozenScript));
+    napi_value frozen = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, frozenScript, &frozen));
+    ASSERT_EQ(napi_set_elements(env, frozen, 0, values, 2), napi_pending_exception);
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    ASSERT_EQ(napi_get_elements(env, object, 0, 1, results), napi_array_expected);
+}
+
+/**
+ * @tc.name: ArrayNumbersTest
+ * @tc.desc: Test bulk conversion between number arrays and native buffers.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, ArrayNumbersTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    const double numbers[] = { 1, -2.5, 3e9, 0.25 };
+    napi_value array = nullptr;
+    ASSERT_CHECK_CALL(napi_create_array_from_numbers(env, napi_float64_array, numbers, 4, &array));
+    uint32_t length = 0;
+    ASSERT_CHECK_CALL(napi_get_array_length(env, array, &length));
+    ASSERT_EQ(length, (uint32_t)4);
+
+    napi_value text = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "text", NAPI_AUTO_LENGTH, &text));
+    ASSERT_CHECK_CALL(napi_set_element(env, array, 2, text));
+
+    double doubles[5] = { 0 };
+    uint32_t invalidIndices[5] = { 0 };
+    size_t invalidCount = 0;
+    ASSERT_CHECK_CALL(napi_get_array_numbers(env, array, napi_float64_array, doubles, 5, invalidIndices, 5,
+                                             &invalidCount));
+    ASSERT_EQ(invalidCount, (size_t)2);
+    ASSERT_EQ(invalidIndices[0], (uint32_t)2);
+    ASSERT_EQ(invalidIndices[1], (uint32_t)4);
+    ASSERT_EQ(doubles[0], 1);
+    ASSERT_EQ(doubles[1], -2.5);
+    ASSERT_TRUE(std::isnan(doubles[2]));
+    ASSERT_EQ(doubles[3], 0.25);
+
+    int32_t ints[4] = { 0 };
+    ASSERT_CHECK_CALL(napi_get_array_numbers(env, array, napi_int32_array, ints, 4, nullptr, 0, &invalidCount));
+    ASSERT_EQ(invalidCount, (size_t)1);
+    ASSERT_EQ(ints[1], -2);
+    ASSERT_EQ(ints[3], 0);
+
+    // Indices beyond the capacity are counted but not written.
+    uint32_t firstInvalid[2] = { 0, UINT32_MAX };
+    ASSERT_CHECK_CALL(napi_get_array_numbers(env, array, napi_float64_array, doubles, 5, firstInvalid, 1,
+                                             &invalidCount));
+    ASSERT_EQ(invalidCount, (size_t)2);
+    ASSERT_EQ(firstInvalid[0], (uint32_t)2);
+    ASSERT_EQ(firstInvalid[1], UINT32_MAX);
+
+    napi_value arrayBuffer = nullptr;
+    void* bufferData = nullptr;
+    ASSERT_CHECK_CALL(napi_create_arraybuffer(env, 4 * sizeof(int16_t), &bufferData, &arrayBuffer));
+    auto shorts = static_cast<int16_t*>(bufferData);
+    shorts[0] = 7;
+    shorts[1] = -8;
+    shorts[2] = 9;
+    shorts[3] = -10;
+    napi_value typedArray = nullptr;
+    ASSERT_CHECK_CALL(napi_create_typedarray(env, napi_int16_array, 3, arrayBuffer, sizeof(int16_t), &typedArray));
+    float floats[4] = { 0 };
+    ASSERT_CHECK_CALL(napi_get_array_numbers(env, typedArray, napi_float32_array, floats, 4, invalidIndices, 5,
+                                             &invalidCount));
+    ASSERT_EQ(invalidCount, (size_t)1);
+    ASSERT_EQ(invalidIndices[0], (uint32_t)3);
+    ASSERT_EQ(floats[0], -8.0f);
+    ASSERT_EQ(floats[2], -10.0f);
+
+    // A throwing getter is an error, not an invalid element.
+    const char* source = "(function() { const a = [1, 2]; "
+                         "Object.defineProperty(a, 1, { get() { throw new Error('get'); } }); return a; })()";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value throwing = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &throwing));
+    ASSERT_EQ(napi_get_array_numbers(env, throwing, napi_float64_array, doubles, 2, nullptr, 0, &invalidCount),
+              napi_pending_exception);
+
+    ASSERT_EQ(napi_get_array_numbers(env, text, napi_float64_array, doubles, 1, nullptr, 0, nullptr),
+              napi_array_expected);
+    ASSERT_EQ(napi_get_array_numbers(env, array, napi_int8_array, doubles, 1, nullptr, 0, nullptr),
+              napi_invalid_arg);
+    ASSERT_EQ(napi_get_array_numbers(env, array, napi_float64_array, doubles, 1, nullptr, 1, nullptr),
+              napi_invalid_arg);
+}
+
 /**
  * @tc.name: ArrayBufferTest
  * @tc.desc: Test array buffer type.
@@ -666,6 +1481,60 @@ HWTEST_F(NativeEngineTest, CustomClassTest, testing::ext::TestSize.Level0)
     ASSERT_TRUE(isInstanceOf);
 }
 
+/**
+ * @tc.name: SubclassTest
+ * @tc.desc: Test constructing a JS subclass of a class defined with napi_define_class.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, SubclassTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    auto constructor = [](napi_env env, napi_callback_info info) -> napi_value {
+        size_t argc = 1;
+        napi_value argv[1] = { nullptr };
+        napi_value thisVar = nullptr;
+        napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+        napi_value newTarget = nullptr;
+        napi_get_new_target(env, info, &newTarget);
+        if (argc > 0 && newTarget != nullptr) {
+            napi_set_named_property(env, thisVar, "value", argv[0]);
+        }
+        return thisVar;
+    };
+
+    napi_value baseClass = nullptr;
+    ASSERT_CHECK_CALL(
+        napi_define_class(env, "NativeBase", NAPI_AUTO_LENGTH, constructor, nullptr, 0, nullptr, &baseClass));
+    napi_value global = nullptr;
+    ASSERT_CHECK_CALL(napi_get_global(env, &global));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, global, "NativeBase", baseClass));
+
+    napi_value argument = nullptr;
+    ASSERT_CHECK_CALL(napi_create_int32(env, 5, &argument));
+    napi_value baseInstance = nullptr;
+    ASSERT_CHECK_CALL(napi_new_instance(env, baseClass, 1, &argument, &baseInstance));
+    napi_value value = nullptr;
+    int32_t number = 0;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, baseInstance, "value", &value));
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, value, &number));
+    ASSERT_EQ(number, 5);
+
+    const char* source = "class Derived extends NativeBase {"
+                         "  constructor(v) { super(v); }"
+                         "  twice() { return this.value * 2; }"
+                         "}"
+                         "const derived = new Derived(7);"
+                         "(derived instanceof Derived) && (derived instanceof NativeBase) && derived.twice() === 14;";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &result));
+    bool passed = false;
+    ASSERT_CHECK_CALL(napi_get_value_bool(env, result, &passed));
+    ASSERT_TRUE(passed);
+}
+
 /**
  * @tc.name: AsyncWorkTest
  * @tc.desc: Test async work.
@@ -744,6 +1613,269 @@ HWTEST_F(NativeEngineTest, ObjectWrapperTest, testing::ext::TestSize.Level0)
     ASSERT_STREQ(testStr, tmpTestStr1);
 }
 
+/**
+ * @tc.name: WrapFinalizeTest
+ * @tc.desc: Test that a wrapped pointer is finalized with its object, that napi_wrap fails on objects it can
+ *          not hold, and that napi_remove_wrap does not finalize.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, WrapFinalizeTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value testClass = nullptr;
+    ASSERT_CHECK_CALL(napi_define_class(
+        env, "WrapClass", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            napi_value thisVar = nullptr;
+            napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        nullptr, 0, nullptr, &testClass));
+
+    static int finalizeCount = 0;
+    finalizeCount = 0;
+    auto finalizer = [](napi_env env, void* data, void* hint) {
+        finalizeCount++;
+        ASSERT_EQ(data, hint);
+    };
+    int first = 1;
+    int second = 2;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+    napi_value instance = nullptr;
+    ASSERT_CHECK_CALL(napi_new_instance(env, testClass, 0, nullptr, &instance));
+    ASSERT_CHECK_CALL(napi_wrap(env, instance, &first, finalizer, &first, nullptr));
+
+    // A second wrap fails and keeps the first pointer.
+    ASSERT_EQ(napi_wrap(env, instance, &second, finalizer, &second, nullptr), napi_invalid_arg);
+    void* result = nullptr;
+    ASSERT_CHECK_CALL(napi_unwrap(env, instance, &result));
+    ASSERT_EQ(result, &first);
+
+    ASSERT_CHECK_CALL(napi_remove_wrap(env, instance, &result));
+    ASSERT_EQ(result, &first);
+    ASSERT_CHECK_CALL(napi_unwrap(env, instance, &result));
+    ASSERT_EQ(result, nullptr);
+    ASSERT_EQ(finalizeCount, 0);
+
+    ASSERT_CHECK_CALL(napi_wrap(env, instance, &second, finalizer, &second, nullptr));
+    ASSERT_CHECK_CALL(napi_unwrap(env, instance, &result));
+    ASSERT_EQ(result, &second);
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+
+    // The instance was only held by the scope.
+    ASSERT_EQ(finalizeCount, 1);
+
+    // Plain objects have no room for a pointer.
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    ASSERT_EQ(napi_wrap(env, object, &first, finalizer, &first, nullptr), napi_invalid_arg);
+    ASSERT_CHECK_CALL(napi_unwrap(env, object, &result));
+    ASSERT_EQ(result, nullptr);
+}
+
+/**
+ * @tc.name: TypeTagTest
+ * @tc.desc: Test napi_type_tag_object, napi_check_object_type_tag and napi_unwrap_tagged.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, TypeTagTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value testClass = nullptr;
+    ASSERT_CHECK_CALL(napi_define_class(
+        env, "TagClass", NAPI_AUTO_LENGTH,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            napi_value thisVar = nullptr;
+            napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        nullptr, 0, nullptr, &testClass));
+
+    const napi_type_tag fooTag = { 0x1f2e3d4c5b6a7988, 0x0123456789abcdef };
+    const napi_type_tag barTag = { 0x1f2e3d4c5b6a7988, 0x0123456789abcdee };
+    static int nativeObject = 0;
+
+    napi_value instance = nullptr;
+    ASSERT_CHECK_CALL(napi_new_instance(env, testClass, 0, nullptr, &instance));
+    bool result = true;
+    ASSERT_CHECK_CALL(napi_check_object_type_tag(env, instance, &fooTag, &result));
+    ASSERT_FALSE(result);
+
+    // The tag may be set before the object is wrapped, and only once.
+    ASSERT_CHECK_CALL(napi_type_tag_object(env, instance, &fooTag));
+    ASSERT_EQ(napi_type_tag_object(env, instance, &barTag), napi_invalid_arg);
+    ASSERT_CHECK_CALL(napi_check_object_type_tag(env, instance, &fooTag, &result));
+    ASSERT_TRUE(result);
+    ASSERT_CHECK_CALL(napi_check_object_type_tag(env, instance, &barTag, &result));
+    ASSERT_FALSE(result);
+
+    void* pointer = nullptr;
+    ASSERT_CHECK_CALL(napi_unwrap_tagged(env, instance, &fooTag, &pointer));
+    ASSERT_EQ(pointer, nullptr);
+    ASSERT_CHECK_CALL(napi_wrap(env, instance, &nativeObject, [](napi_env env, void* data, void* hint) {},
+                                nullptr, nullptr));
+    ASSERT_CHECK_CALL(napi_unwrap_tagged(env, instance, &fooTag, &pointer));
+    ASSERT_EQ(pointer, &nativeObject);
+    ASSERT_CHECK_CALL(napi_unwrap_tagged(env, instance, &barTag, &pointer));
+    ASSERT_EQ(pointer, nullptr);
+
+    // Removing the wrap keeps the tag.
+    ASSERT_CHECK_CALL(napi_remove_wrap(env, instance, &pointer));
+    ASSERT_EQ(pointer, &nativeObject);
+    ASSERT_CHECK_CALL(napi_check_object_type_tag(env, instance, &fooTag, &result));
+    ASSERT_TRUE(result);
+
+    // An untagged wrapped object does not match any tag.
+    napi_value untagged = nullptr;
+    ASSERT_CHECK_CALL(napi_new_instance(env, testClass, 0, nullptr, &untagged));
+    ASSERT_CHECK_CALL(napi_wrap(env, untagged, &nativeObject, [](napi_env env, void* data, void* hint) {},
+                                nullptr, nullptr));
+    ASSERT_CHECK_CALL(napi_unwrap_tagged(env, untagged, &fooTag, &pointer));
+    ASSERT_EQ(pointer, nullptr);
+}
+
+/**
+ * @tc.name: FunctionTemplateTest
+ * @tc.desc: Test functions made from a template, and accessors defined with a single native callback.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, FunctionTemplateTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    static int32_t base = 40;
+    napi_function_template functionTemplate = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function_template(
+        env,
+        [](napi_env env, napi_callback_info info) -> napi_value {
+            size_t argc = 1;
+            napi_value argv[1] = { nullptr };
+            void* data = nullptr;
+            napi_get_cb_info(env, info, &argc, argv, nullptr, &data);
+            int32_t value = 0;
+            napi_get_value_int32(env, argv[0], &value);
+            napi_value result = nullptr;
+            napi_create_int32(env, *(int32_t*)data + value, &result);
+            return result;
+        },
+        &base, &functionTemplate));
+
+    napi_value first = nullptr;
+    napi_value second = nullptr;
+    ASSERT_CHECK_CALL(napi_create_function_from_template(env, functionTemplate, &first));
+    ASSERT_CHECK_CALL(napi_create_function_from_template(env, functionTemplate, &second));
+    ASSERT_CHECK_VALUE_TYPE(env, first, napi_function);
+    bool equals = true;
+    ASSERT_CHECK_CALL(napi_strict_equals(env, first, second, &equals));
+    ASSERT_FALSE(equals);
+
+    // Functions stay callable after their template is released.
+    ASSERT_CHECK_CALL(napi_delete_function_template(env, functionTemplate));
+    napi_value undefined = nullptr;
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &undefined));
+    napi_value argv[1] = { nullptr };
+    ASSERT_CHECK_CALL(napi_create_int32(env, 2, &argv[0]));
+    for (napi_value function : { first, second }) {
+        napi_value result = nullptr;
+        ASSERT_CHECK_CALL(napi_call_function(env, undefined, function, 1, argv, &result));
+        int32_t value = 0;
+        ASSERT_CHECK_CALL(napi_get_value_int32(env, result, &value));
+        ASSERT_EQ(value, 42);
+    }
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    napi_property_descriptor desc[] = {
+        { "readOnly", nullptr, nullptr,
+          [](napi_env env, napi_callback_info info) -> napi_value {
+              napi_value result = nullptr;
+              napi_create_int32(env, 7, &result);
+              return result;
+          },
+          nullptr, nullptr, napi_default, nullptr },
+    };
+    ASSERT_CHECK_CALL(napi_define_properties(env, object, 1, desc));
+    napi_value global = nullptr;
+    ASSERT_CHECK_CALL(napi_get_global(env, &global));
+    ASSERT_CHECK_CALL(napi_set_named_property(env, global, "templateTestObject", object));
+
+    const char* source = "const d = Object.getOwnPropertyDescriptor(templateTestObject, 'readOnly');"
+                         "typeof d.get === 'function' && d.set === undefined && templateTestObject.readOnly === 7;";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &result));
+    bool passed = false;
+    ASSERT_CHECK_CALL(napi_get_value_bool(env, result, &passed));
+    ASSERT_TRUE(passed);
+}
+
+/**
+ * @tc.name: ObjectTemplateTest
+ * @tc.desc: Test napi_create_object_from_template and napi_define_properties_from_template.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, ObjectTemplateTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    const char* names[] = { "id", "name", "score" };
+    napi_object_template objectTemplate = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object_template(env, names, 3, &objectTemplate));
+
+    napi_value values[3] = { nullptr };
+    ASSERT_CHECK_CALL(napi_create_int32(env, 7, &values[0]));
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, "record", NAPI_AUTO_LENGTH, &values[1]));
+    napi_value record = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object_from_template(env, objectTemplate, values, &record));
+    ASSERT_CHECK_VALUE_TYPE(env, record, napi_object);
+
+    // Fields keep the template order, and a null value is undefined.
+    napi_value keys = nullptr;
+    ASSERT_CHECK_CALL(napi_get_property_names(env, record, &keys));
+    uint32_t keyCount = 0;
+    ASSERT_CHECK_CALL(napi_get_array_length(env, keys, &keyCount));
+    ASSERT_EQ(keyCount, 3U);
+    for (uint32_t i = 0; i < keyCount; i++) {
+        napi_value key = nullptr;
+        ASSERT_CHECK_CALL(napi_get_element(env, keys, i, &key));
+        char buffer[8] = { 0 };
+        size_t length = 0;
+        ASSERT_CHECK_CALL(napi_get_value_string_utf8(env, key, buffer, sizeof(buffer), &length));
+        ASSERT_STREQ(buffer, names[i]);
+    }
+    napi_value id = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, record, "id", &id));
+    int32_t idValue = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, id, &idValue));
+    ASSERT_EQ(idValue, 7);
+    napi_value score = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, record, "score", &score));
+    ASSERT_CHECK_VALUE_TYPE(env, score, napi_undefined);
+
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    ASSERT_CHECK_CALL(napi_define_properties_from_template(env, object, objectTemplate, values));
+    napi_value name = nullptr;
+    ASSERT_CHECK_CALL(napi_get_named_property(env, object, "name", &name));
+    bool equals = false;
+    ASSERT_CHECK_CALL(napi_strict_equals(env, name, values[1], &equals));
+    ASSERT_TRUE(equals);
+
+    const char* source = "Object.freeze({})";
+    napi_value script = nullptr;
+    ASSERT_CHECK_CALL(napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script));
+    napi_value frozen = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &frozen));
+    ASSERT_EQ(napi_define_properties_from_template(env, frozen, objectTemplate, values), napi_generic_failure);
+
+    ASSERT_CHECK_CALL(napi_delete_object_template(env, objectTemplate));
+}
+
 /**
  * @tc.name: RunScriptTest
  * @tc.desc: Test script running.
@@ -815,6 +1947,59 @@ HWTEST_F(NativeEngineTest, StrictEqualsTest, testing::ext::TestSize.Level0)
     isStrictEquals = false;
     napi_strict_equals(env, testObject, testObject, &isStrictEquals);
     ASSERT_TRUE(isStrictEquals);
+
+    napi_value otherString = nullptr;
+    napi_create_string_utf8(env, testStringStr, strlen(testStringStr), &otherString);
+    napi_strict_equals(env, testString, otherString, &isStrictEquals);
+    ASSERT_TRUE(isStrictEquals);
+    napi_create_string_utf8(env, "tesT", NAPI_AUTO_LENGTH, &otherString);
+    napi_strict_equals(env, testString, otherString, &isStrictEquals);
+    ASSERT_FALSE(isStrictEquals);
+
+    napi_value otherObject = nullptr;
+    napi_create_object(env, &otherObject);
+    napi_strict_equals(env, testObject, otherObject, &isStrictEquals);
+    ASSERT_FALSE(isStrictEquals);
+
+    napi_value intValue = nullptr;
+    napi_value doubleValue = nullptr;
+    napi_create_int32(env, 2, &intValue);
+    napi_create_double(env, 2.0, &doubleValue);
+    napi_strict_equals(env, intValue, doubleValue, &isStrictEquals);
+    ASSERT_TRUE(isStrictEquals);
+
+    napi_value nanValue = nullptr;
+    napi_create_double(env, NAN, &nanValue);
+    napi_strict_equals(env, nanValue, nanValue, &isStrictEquals);
+    ASSERT_FALSE(isStrictEquals);
+
+    napi_value stringNumber = nullptr;
+    napi_create_string_utf8(env, "2", NAPI_AUTO_LENGTH, &stringNumber);
+    napi_strict_equals(env, intValue, stringNumber, &isStrictEquals);
+    ASSERT_FALSE(isStrictEquals);
+
+    napi_value undefined = nullptr;
+    napi_value null = nullptr;
+    napi_get_undefined(env, &undefined);
+    napi_get_null(env, &null);
+    napi_strict_equals(env, undefined, null, &isStrictEquals);
+    ASSERT_FALSE(isStrictEquals);
+
+    // Equal big integers held by different values, when the engine has them.
+    const char* source = "(typeof BigInt === 'function') ? "
+                         "[BigInt(10), BigInt(5) * BigInt(2), BigInt(11)] : [1, 1, 2]";
+    napi_value script = nullptr;
+    napi_create_string_utf8(env, source, NAPI_AUTO_LENGTH, &script);
+    napi_value bigValues = nullptr;
+    ASSERT_CHECK_CALL(napi_run_script(env, script, &bigValues));
+    napi_value bigValue[3] = { nullptr };
+    for (uint32_t i = 0; i < 3; i++) {
+        ASSERT_CHECK_CALL(napi_get_element(env, bigValues, i, &bigValue[i]));
+    }
+    napi_strict_equals(env, bigValue[0], bigValue[1], &isStrictEquals);
+    ASSERT_TRUE(isStrictEquals);
+    napi_strict_equals(env, bigValue[0], bigValue[2], &isStrictEquals);
+    ASSERT_FALSE(isStrictEquals);
 }
 
 /**
@@ -907,6 +2092,21 @@ HWTEST_F(NativeEngineTest, EncodeToUtf8Test, testing::ext::TestSize.Level0)
     ASSERT_EQ(nchars, 8);
     delete[] buffer;
 
+    str = "a\xf0\x9f\x98\x80";
+    testStr = engine_->CreateString(str.c_str(), str.length());
+    buffer = new char[str.length()];
+    bufferSize = str.length();
+    memset_s(buffer, str.length(), 0, str.length());
+    engine_->EncodeToUtf8(testStr, buffer, &written, bufferSize, &nchars);
+    ASSERT_EQ(written, 5);
+    ASSERT_EQ(nchars, 3);
+    ASSERT_EQ(memcmp(buffer, str.c_str(), str.length()), 0);
+    bufferSize--;
+    engine_->EncodeToUtf8(testStr, buffer, &written, bufferSize, &nchars);
+    ASSERT_EQ(written, 1);
+    ASSERT_EQ(nchars, 1);
+    delete[] buffer;
+
     str = "";
     testStr = engine_->CreateString(str.c_str(), str.length());
     buffer = new char[str.length() + 1];
@@ -917,3 +2117,136 @@ HWTEST_F(NativeEngineTest, EncodeToUtf8Test, testing::ext::TestSize.Level0)
     ASSERT_EQ(nchars, 0);
     delete[] buffer;
 }
+
+/**
+ * @tc.name: EscapeHandleScopeTest
+ * @tc.desc: Test escapable handle scope.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, EscapeHandleScopeTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+
+    napi_escapable_handle_scope escapableScope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_escapable_handle_scope(env, &escapableScope));
+    napi_value object = nullptr;
+    ASSERT_CHECK_CALL(napi_create_object(env, &object));
+    for (int32_t i = 0; i < 1000; i++) {
+        napi_value temp = nullptr;
+        ASSERT_CHECK_CALL(napi_create_int32(env, i, &temp));
+    }
+    napi_value escaped = nullptr;
+    ASSERT_CHECK_CALL(napi_escape_handle(env, escapableScope, object, &escaped));
+    napi_value escapedAgain = nullptr;
+    ASSERT_EQ(napi_escape_handle(env, escapableScope, object, &escapedAgain), napi_escape_called_twice);
+    ASSERT_CHECK_CALL(napi_close_escapable_handle_scope(env, escapableScope));
+
+    ASSERT_CHECK_VALUE_TYPE(env, escaped, napi_object);
+
+    // Each escape leaves only the escaped value behind in the outer scope.
+    for (int32_t i = 0; i < 1000; i++) {
+        ASSERT_CHECK_CALL(napi_open_escapable_handle_scope(env, &escapableScope));
+        napi_value temp = nullptr;
+        ASSERT_CHECK_CALL(napi_create_string_utf8(env, "temp", NAPI_AUTO_LENGTH, &temp));
+        ASSERT_CHECK_CALL(napi_create_object(env, &object));
+        ASSERT_CHECK_CALL(napi_escape_handle(env, escapableScope, object, &escaped));
+        ASSERT_CHECK_CALL(napi_close_escapable_handle_scope(env, escapableScope));
+        ASSERT_CHECK_VALUE_TYPE(env, escaped, napi_object);
+    }
+
+    // Values the scope does not own escape as well: shared singletons as they are, and values
+    // of an outer scope as a new handle.
+    napi_value undefined = nullptr;
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &undefined));
+    ASSERT_CHECK_CALL(napi_open_escapable_handle_scope(env, &escapableScope));
+    ASSERT_CHECK_CALL(napi_escape_handle(env, escapableScope, undefined, &escapedAgain));
+    ASSERT_CHECK_CALL(napi_close_escapable_handle_scope(env, escapableScope));
+    ASSERT_EQ(escapedAgain, undefined);
+
+    ASSERT_CHECK_CALL(napi_open_escapable_handle_scope(env, &escapableScope));
+    ASSERT_CHECK_CALL(napi_escape_handle(env, escapableScope, escaped, &escapedAgain));
+    ASSERT_CHECK_CALL(napi_close_escapable_handle_scope(env, escapableScope));
+    bool equals = false;
+    ASSERT_CHECK_CALL(napi_strict_equals(env, escaped, escapedAgain, &equals));
+    ASSERT_TRUE(equals);
+
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+}
+
+/**
+ * @tc.name: SingletonValueTest
+ * @tc.desc: Test undefined, null, boolean and small integer values are shared.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, SingletonValueTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+
+    napi_value undefined = nullptr;
+    napi_value null = nullptr;
+    napi_value trueValue = nullptr;
+    napi_value smallInteger = nullptr;
+
+    napi_handle_scope scope = nullptr;
+    ASSERT_CHECK_CALL(napi_open_handle_scope(env, &scope));
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &undefined));
+    ASSERT_CHECK_CALL(napi_get_null(env, &null));
+    ASSERT_CHECK_CALL(napi_get_boolean(env, true, &trueValue));
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &smallInteger));
+    ASSERT_CHECK_CALL(napi_close_handle_scope(env, scope));
+
+    napi_value result = nullptr;
+    ASSERT_CHECK_CALL(napi_get_undefined(env, &result));
+    ASSERT_EQ(result, undefined);
+    ASSERT_CHECK_CALL(napi_get_null(env, &result));
+    ASSERT_EQ(result, null);
+    ASSERT_CHECK_CALL(napi_get_boolean(env, true, &result));
+    ASSERT_EQ(result, trueValue);
+    ASSERT_CHECK_CALL(napi_create_int32(env, 1, &result));
+    ASSERT_EQ(result, smallInteger);
+
+    ASSERT_CHECK_VALUE_TYPE(env, undefined, napi_undefined);
+    ASSERT_CHECK_VALUE_TYPE(env, null, napi_null);
+    ASSERT_CHECK_VALUE_TYPE(env, trueValue, napi_boolean);
+    ASSERT_CHECK_VALUE_TYPE(env, smallInteger, napi_number);
+
+    int32_t cValue = 0;
+    ASSERT_CHECK_CALL(napi_get_value_int32(env, smallInteger, &cValue));
+    ASSERT_EQ(cValue, 1);
+}
+
+/**
+ * @tc.name: TypeCheckSpoofTest
+ * @tc.desc: Test type checks do not trust the constructor name.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NativeEngineTest, TypeCheckSpoofTest, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    const char* names[] = { "External", "Promise", "ArrayBuffer", "DataView", "Uint8Array" };
+
+    for (const char* name : names) {
+        napi_value object = nullptr;
+        napi_value constructor = nullptr;
+        napi_value constructorName = nullptr;
+        ASSERT_CHECK_CALL(napi_create_object(env, &object));
+        ASSERT_CHECK_CALL(napi_create_object(env, &constructor));
+        ASSERT_CHECK_CALL(napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &constructorName));
+        ASSERT_CHECK_CALL(napi_set_named_property(env, constructor, "name", constructorName));
+        ASSERT_CHECK_CALL(napi_set_named_property(env, object, "constructor", constructor));
+
+        ASSERT_CHECK_VALUE_TYPE(env, object, napi_object);
+        bool result = true;
+        ASSERT_CHECK_CALL(napi_is_promise(env, object, &result));
+        ASSERT_FALSE(result);
+        ASSERT_CHECK_CALL(napi_is_arraybuffer(env, object, &result));
+        ASSERT_FALSE(result);
+        ASSERT_CHECK_CALL(napi_is_dataview(env, object, &result));
+        ASSERT_FALSE(result);
+        ASSERT_CHECK_CALL(napi_is_typedarray(env, object, &result));
+        ASSERT_FALSE(result);
+    }
+}